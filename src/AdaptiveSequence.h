@@ -0,0 +1,385 @@
+#ifndef AISDI_LINEAR_ADAPTIVESEQUENCE_H
+#define AISDI_LINEAR_ADAPTIVESEQUENCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "LinkedList.h"
+#include "Vector.h"
+
+namespace aisdi
+{
+
+// Sequence stored either as a Vector or as a LinkedList, switching between
+// them as the operation mix changes. Every operation is charged to both
+// representations by a simple cost model, in roughly nanoseconds as measured
+// with aisdiLinearBench: Vector pays for shifted elements, the list pays for
+// node allocation and for pointer chasing on iterator steps (an iterator + k
+// walks k nodes, where the Vector jumps). Costs
+// decay by half every DECAY_PERIOD operations, so the model follows phases;
+// once the current representation has cost more than the other by the price
+// of converting, the elements are moved over. The lead the current one can
+// build up is capped at that price too, so after a phase change switching
+// back takes at most two conversions' worth of work. Conversions only happen
+// inside mutating calls, which invalidate iterators anyway.
+template <typename Type>
+class AdaptiveSequence
+{
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = Type;
+  using pointer = Type*;
+  using reference = Type&;
+  using const_pointer = const Type*;
+  using const_reference = const Type&;
+
+  class ConstIterator;
+  class Iterator;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  enum class Representation { Contiguous, Linked };
+
+  static const std::uint64_t DECAY_PERIOD = 1024;
+  static const size_type MIN_ADAPTIVE_SIZE = 64; // smaller sequences stay as they are
+  static const std::uint64_t SHIFT_COST = 4;       // moving one Vector element
+  static const std::uint64_t CONTIGUOUS_STEP_COST = 1;
+  static const std::uint64_t LINKED_STEP_COST = 5; // one iterator step in the list
+  static const std::uint64_t NODE_COST = 15;       // allocating or freeing a list node
+
+  AdaptiveSequence() : current(Representation::Contiguous), contiguousCost(0), linkedCost(0), charged(0),
+                       steps(0), walked(0), jumps(0) {}
+
+  AdaptiveSequence(std::initializer_list<Type> l) : AdaptiveSequence() {
+    for(auto it = l.begin(); it != l.end(); ++it)
+      append(*it);
+  }
+
+  bool isEmpty() const {
+    return !getSize();
+  }
+
+  size_type getSize() const {
+    return current == Representation::Contiguous ? contiguous.getSize() : linked.getSize();
+  }
+
+  Representation representation() const {
+    return current;
+  }
+
+  // Moves the elements to the given representation and restarts the model.
+  void convertTo(Representation target) {
+    if(target == current)
+      return;
+    if(target == Representation::Linked) {
+      for(auto it = contiguous.cbegin(); it != contiguous.cend(); ++it)
+        linked.append(*it);
+      contiguous = UnpackedVector<Type>();
+    }
+    else {
+      contiguous.reserve(linked.getSize());
+      for(auto it = linked.cbegin(); it != linked.cend(); ++it)
+        contiguous.append(*it);
+      linked = LinkedList<Type>();
+    }
+    current = target;
+    contiguousCost = linkedCost = 0;
+    charged = 0;
+  }
+
+  void append(const Type& item) {
+    if(current == Representation::Contiguous)
+      contiguous.append(item);
+    else
+      linked.append(item);
+    charge(2 * SHIFT_COST, NODE_COST); // amortized growth copies one element per append
+  }
+
+  void prepend(const Type& item) {
+    std::uint64_t shifted = getSize();
+    if(current == Representation::Contiguous)
+      contiguous.prepend(item);
+    else
+      linked.prepend(item);
+    charge((shifted + 1) * SHIFT_COST, NODE_COST);
+  }
+
+  void insert(const const_iterator& insertPosition, const Type& item) {
+    if(insertPosition.mode != current)
+      throw std::logic_error("Attempt to use iterator from before a conversion");
+    if(insertPosition.index > getSize())
+      throw std::out_of_range("Attempt to insert out of sequence range");
+    std::uint64_t shifted = getSize() - insertPosition.index;
+    if(current == Representation::Contiguous)
+      contiguous.insert(contiguous.cbegin() + insertPosition.index, item);
+    else
+      linked.insert(insertPosition.node, item);
+    charge((shifted + 1) * SHIFT_COST, NODE_COST);
+  }
+
+  Type popFirst() {
+    if(isEmpty())
+      throw std::logic_error("Attempt to pop first in empty sequence");
+    Type item = current == Representation::Contiguous ? Type(contiguous.popFirst()) : linked.popFirst();
+    charge((getSize() + 1) * SHIFT_COST, NODE_COST);
+    return item;
+  }
+
+  Type popLast() {
+    if(isEmpty())
+      throw std::logic_error("Attempt to pop last in empty sequence");
+    Type item = current == Representation::Contiguous ? Type(contiguous.popLast()) : linked.popLast();
+    charge(SHIFT_COST, NODE_COST);
+    return item;
+  }
+
+  void erase(const const_iterator& position) {
+    if(position.index >= getSize())
+      throw std::out_of_range("attempt to erase at end iterator");
+    erase(position, position + 1);
+  }
+
+  void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded) {
+    if(isEmpty())
+      throw std::out_of_range("attempt to erase empty sequence");
+    if(firstIncluded.mode != current || lastExcluded.mode != current)
+      throw std::logic_error("Attempt to use iterator from before a conversion");
+    if(firstIncluded.index > lastExcluded.index)
+      throw std::out_of_range("attempt to erase reversed range");
+    size_type count = lastExcluded.index - firstIncluded.index;
+    if(current == Representation::Contiguous)
+      contiguous.erase(contiguous.cbegin() + firstIncluded.index, contiguous.cbegin() + lastExcluded.index);
+    else
+      linked.erase(firstIncluded.node, lastExcluded.node);
+    charge((getSize() - firstIncluded.index + 1) * SHIFT_COST, count * NODE_COST);
+  }
+
+  iterator begin() {
+    return iterator(cbegin());
+  }
+
+  iterator end() {
+    return iterator(cend());
+  }
+
+  const_iterator cbegin() const {
+    return const_iterator(this, 0, linked.cbegin());
+  }
+
+  const_iterator cend() const {
+    return const_iterator(this, getSize(), linked.cend());
+  }
+
+  const_iterator begin() const {
+    return cbegin();
+  }
+
+  const_iterator end() const {
+    return cend();
+  }
+
+private:
+  // Folds in the iterator movement seen since the last call, then checks
+  // whether the other representation has become cheaper by more than the
+  // conversion would cost.
+  void charge(std::uint64_t contiguousWork, std::uint64_t linkedWork) {
+    contiguousCost += contiguousWork + (steps + jumps) * CONTIGUOUS_STEP_COST;
+    linkedCost += linkedWork + (steps + walked) * LINKED_STEP_COST;
+    steps = walked = jumps = 0;
+    if(++charged == DECAY_PERIOD) {
+      contiguousCost /= 2;
+      linkedCost /= 2;
+      charged = 0;
+    }
+    size_type size = getSize();
+    if(size < MIN_ADAPTIVE_SIZE)
+      return;
+    std::uint64_t conversion = size * (NODE_COST + LINKED_STEP_COST);
+    if(current == Representation::Contiguous) {
+      if(contiguousCost > linkedCost + conversion)
+        convertTo(Representation::Linked);
+      else if(linkedCost > contiguousCost + conversion)
+        linkedCost = contiguousCost + conversion;
+    }
+    else {
+      if(linkedCost > contiguousCost + conversion)
+        convertTo(Representation::Contiguous);
+      else if(contiguousCost > linkedCost + conversion)
+        contiguousCost = linkedCost + conversion;
+    }
+  }
+
+  const_reference element(const ConstIterator& position) const {
+    if(position.mode != current)
+      throw std::logic_error("Attempt to use iterator from before a conversion");
+    if(current == Representation::Contiguous)
+      return detail::unpacked(contiguous.data()[position.index]);
+    return *position.node;
+  }
+
+  Representation current;
+  UnpackedVector<Type> contiguous; // empty while Linked, a byte per bool
+  LinkedList<Type> linked; // empty while Contiguous
+  std::uint64_t contiguousCost;
+  std::uint64_t linkedCost;
+  std::uint64_t charged;
+  mutable std::uint64_t steps;  // iterator ++ and --
+  mutable std::uint64_t walked; // nodes an iterator + or - would walk
+  mutable std::uint64_t jumps;  // iterator + and - calls
+};
+
+template <typename Type>
+class AdaptiveSequence<Type>::ConstIterator
+{
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename AdaptiveSequence::value_type;
+  using difference_type = typename AdaptiveSequence::difference_type;
+  using pointer = typename AdaptiveSequence::const_pointer;
+  using reference = typename AdaptiveSequence::const_reference;
+  using NodeIterator = typename LinkedList<Type>::const_iterator;
+
+  ConstIterator() : seq(nullptr), index(0), mode(Representation::Contiguous) {}
+
+  ConstIterator(const AdaptiveSequence* s, size_type i, NodeIterator n)
+    : seq(s), index(i), node(n), mode(s->current) {}
+
+  reference operator*() const {
+    if(index >= seq->getSize())
+      throw std::out_of_range("Attempt to dereference end iterator");
+    return seq->element(*this);
+  }
+
+  ConstIterator& operator++() {
+    if(index == seq->getSize())
+      throw std::out_of_range("Attempt to increment end iterator");
+    ++index;
+    if(mode == Representation::Linked)
+      ++node;
+    ++seq->steps;
+    return *this;
+  }
+
+  ConstIterator operator++(int) {
+    ConstIterator result = *this;
+    operator++();
+    return result;
+  }
+
+  ConstIterator& operator--() {
+    if(index == 0)
+      throw std::out_of_range("Attempt to decrement begin iterator");
+    --index;
+    if(mode == Representation::Linked)
+      --node;
+    ++seq->steps;
+    return *this;
+  }
+
+  ConstIterator operator--(int) {
+    ConstIterator result = *this;
+    operator--();
+    return result;
+  }
+
+  ConstIterator operator+(difference_type d) const {
+    if(d < 0)
+      return operator-(-d);
+    if(index + d > seq->getSize())
+      throw std::out_of_range("Attempt to add out of sequence range");
+    ConstIterator result = *this;
+    result.index += d;
+    if(mode == Representation::Linked)
+      result.node = node + d;
+    ++seq->jumps;
+    seq->walked += d;
+    return result;
+  }
+
+  ConstIterator operator-(difference_type d) const {
+    if(d < 0)
+      return operator+(-d);
+    if(d > static_cast<difference_type>(index))
+      throw std::out_of_range("Attempt to substract out of sequence range");
+    ConstIterator result = *this;
+    result.index -= d;
+    if(mode == Representation::Linked)
+      for(difference_type i = 0; i < d; ++i)
+        --result.node;
+    ++seq->jumps;
+    seq->walked += d;
+    return result;
+  }
+
+  bool operator==(const ConstIterator& other) const {
+    return seq == other.seq && index == other.index;
+  }
+
+  bool operator!=(const ConstIterator& other) const {
+    return !operator==(other);
+  }
+
+protected:
+  const AdaptiveSequence* seq;
+  size_type index;
+  NodeIterator node; // used while Linked
+  Representation mode;
+
+  friend class AdaptiveSequence;
+};
+
+template <typename Type>
+class AdaptiveSequence<Type>::Iterator : public AdaptiveSequence<Type>::ConstIterator
+{
+public:
+  using pointer = typename AdaptiveSequence::pointer;
+  using reference = typename AdaptiveSequence::reference;
+
+  Iterator() {}
+
+  Iterator(const ConstIterator& other)
+    : ConstIterator(other) {}
+
+  Iterator& operator++() {
+    ConstIterator::operator++();
+    return *this;
+  }
+
+  Iterator operator++(int) {
+    auto result = *this;
+    ConstIterator::operator++();
+    return result;
+  }
+
+  Iterator& operator--() {
+    ConstIterator::operator--();
+    return *this;
+  }
+
+  Iterator operator--(int) {
+    auto result = *this;
+    ConstIterator::operator--();
+    return result;
+  }
+
+  Iterator operator+(difference_type d) const {
+    return ConstIterator::operator+(d);
+  }
+
+  Iterator operator-(difference_type d) const {
+    return ConstIterator::operator-(d);
+  }
+
+  reference operator*() const {
+    // ugly cast, yet reduces code duplication.
+    return const_cast<reference>(ConstIterator::operator*());
+  }
+};
+
+}
+
+#endif // AISDI_LINEAR_ADAPTIVESEQUENCE_H
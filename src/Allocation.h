@@ -0,0 +1,127 @@
+#ifndef AISDI_LINEAR_ALLOCATION_H
+#define AISDI_LINEAR_ALLOCATION_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+#include <sys/mman.h>
+
+#include "BufferCache.h"
+
+// Raw storage for container buffers: aligned heap blocks, or anonymous
+// mappings backed by huge pages for large buffers when a container opts in.
+// Whether a buffer is mapped follows from its size and the opt-in flag, so the
+// same pair must be passed when it is released. Heap blocks go through the
+// calling thread's BufferCache, which passes everything through until it is
+// given a capacity.
+
+namespace aisdi
+{
+namespace detail
+{
+
+const std::size_t HUGE_PAGE_SIZE = std::size_t(2) << 20;
+const std::size_t MAX_BUFFER_ALIGNMENT = 4096; // mappings are page aligned
+
+inline bool isMappedBuffer(std::size_t bytes, bool hugePages) {
+  return hugePages && bytes >= HUGE_PAGE_SIZE;
+}
+
+inline std::size_t roundToHugePages(std::size_t bytes) {
+  return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+}
+
+// Transparent huge pages where the kernel allows madvise; otherwise pages from
+// the hugetlb pool; plain pages when neither is available.
+inline void* mapHugeBuffer(std::size_t bytes) {
+  std::size_t length = roundToHugePages(bytes);
+  void* mapped = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if(mapped == MAP_FAILED)
+    throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+  if(::madvise(mapped, length, MADV_HUGEPAGE) == 0)
+    return mapped;
+#endif
+#ifdef MAP_HUGETLB
+  void* huge = ::mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if(huge != MAP_FAILED) {
+    ::munmap(mapped, length);
+    return huge;
+  }
+#endif
+  return mapped;
+}
+
+// Estimated bytes the allocator adds to a block of bytes: glibc-style 8 byte
+// header, 16 byte granularity and 32 byte minimum chunks. Mapped buffers are
+// rounded up to whole huge pages instead.
+inline std::size_t allocationOverhead(std::size_t bytes, bool hugePages = false) {
+  if(isMappedBuffer(bytes, hugePages))
+    return roundToHugePages(bytes) - bytes;
+  std::size_t chunk = (bytes + sizeof(std::size_t) + 15) / 16 * 16;
+  return (chunk < 32 ? 32 : chunk) - bytes;
+}
+
+inline void* allocateBuffer(std::size_t bytes, std::size_t alignment, bool hugePages) {
+  if(isMappedBuffer(bytes, hugePages))
+    return mapHugeBuffer(bytes);
+  void* buffer = nullptr;
+  if(alignment < sizeof(void*))
+    alignment = sizeof(void*);
+  BufferCache* cache = BufferCache::local();
+  if(cache && (buffer = cache->acquire(bytes, alignment)))
+    return buffer;
+  if(::posix_memalign(&buffer, alignment, bytes ? bytes : 1) != 0)
+    throw std::bad_alloc();
+  return buffer;
+}
+
+inline void releaseBuffer(void* buffer, std::size_t bytes, bool hugePages) {
+  if(isMappedBuffer(bytes, hugePages)) {
+    ::munmap(buffer, roundToHugePages(bytes));
+    return;
+  }
+  BufferCache* cache = BufferCache::local();
+  if(!cache || !cache->offer(buffer, bytes))
+    std::free(buffer);
+}
+
+template <typename Type>
+void destroyElements(Type* elements, std::size_t count) {
+  if(std::is_trivially_destructible<Type>::value)
+    return;
+  for(std::size_t i = 0; i < count; ++i)
+    elements[i].~Type();
+}
+
+// Default-constructs count elements in place, like new Type[count].
+template <typename Type>
+Type* allocateElements(std::size_t count, std::size_t alignment, bool hugePages) {
+  void* raw = allocateBuffer(count * sizeof(Type), alignment, hugePages);
+  Type* elements = static_cast<Type*>(raw);
+  std::size_t constructed = 0;
+  try {
+    for(; constructed < count; ++constructed)
+      new (elements + constructed) Type;
+  }
+  catch(...) {
+    destroyElements(elements, constructed);
+    releaseBuffer(raw, count * sizeof(Type), hugePages);
+    throw;
+  }
+  return elements;
+}
+
+template <typename Type>
+void releaseElements(Type* elements, std::size_t count, bool hugePages) {
+  destroyElements(elements, count);
+  releaseBuffer(elements, count * sizeof(Type), hugePages);
+}
+
+}
+}
+
+#endif // AISDI_LINEAR_ALLOCATION_H
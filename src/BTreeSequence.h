@@ -0,0 +1,845 @@
+#ifndef AISDI_LINEAR_BTREESEQUENCE_H
+#define AISDI_LINEAR_BTREESEQUENCE_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace aisdi
+{
+
+// Sequence stored in a counted B+ tree (a rope): leaves hold up to
+// LEAF_CAPACITY elements in an array and are linked for iteration, inner
+// nodes hold up to BRANCH children together with each child's element count.
+// Positioning by index is O(log n), so insert, erase and at are O(log n)
+// where Vector shifts and LinkedList walks. Every node except the root is at
+// least half full. concat and split join and cut whole subtrees, O(log n).
+template <typename Type>
+class BTreeSequence
+{
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = Type;
+  using pointer = Type*;
+  using reference = Type&;
+  using const_pointer = const Type*;
+  using const_reference = const Type&;
+
+  class ConstIterator;
+  class Iterator;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  static const size_type LEAF_BYTES = 512;
+  static const size_type LEAF_CAPACITY = LEAF_BYTES / sizeof(Type) < 8 ? 8 : LEAF_BYTES / sizeof(Type);
+  static const size_type BRANCH = 32;
+
+  BTreeSequence() : root(new Leaf()), height(0), size(0) {
+    first = last = static_cast<Leaf*>(root);
+  }
+
+  BTreeSequence(std::initializer_list<Type> l) : BTreeSequence() {
+    for(auto it = l.begin(); it != l.end(); ++it)
+      append(*it);
+  }
+
+  BTreeSequence(const BTreeSequence& other) : BTreeSequence() {
+    for(const Leaf* leaf = other.first; leaf; leaf = leaf->next)
+      for(size_type i = 0; i < leaf->count; ++i)
+        append(leaf->items[i]);
+  }
+
+  BTreeSequence(BTreeSequence&& other) : BTreeSequence() {
+    swap(other);
+  }
+
+  ~BTreeSequence() {
+    destroy(root, height);
+  }
+
+  BTreeSequence& operator=(const BTreeSequence& other) {
+    if(this != &other) {
+      BTreeSequence copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  BTreeSequence& operator=(BTreeSequence&& other) {
+    if(this != &other) {
+      BTreeSequence emptied;
+      swap(other);
+      other.swap(emptied);
+    }
+    return *this;
+  }
+
+  bool isEmpty() const {
+    return !size;
+  }
+
+  size_type getSize() const {
+    return size;
+  }
+
+  size_type getHeight() const { // 0 while everything fits in one leaf
+    return height;
+  }
+
+  const_reference at(size_type index) const {
+    if(index >= size)
+      throw std::out_of_range("Index out of sequence range");
+    size_type offset = index;
+    const Leaf* leaf = leafFor(offset);
+    return leaf->items[offset];
+  }
+
+  reference at(size_type index) {
+    return const_cast<reference>(static_cast<const BTreeSequence&>(*this).at(index));
+  }
+
+  void insert(size_type index, const Type& item) {
+    if(index > size)
+      throw std::out_of_range("Attempt to insert out of sequence range");
+    Type copy = item; // item may live in a leaf that is about to split
+    Node* sibling = insertInto(root, height, index, copy);
+    if(sibling)
+      growRoot(sibling);
+    ++size;
+  }
+
+  void insert(const const_iterator& insertPosition, const Type& item) {
+    insert(insertPosition.index, item);
+  }
+
+  void append(const Type& item) {
+    insert(size, item);
+  }
+
+  void prepend(const Type& item) {
+    insert(0, item);
+  }
+
+  Type erase(size_type index) {
+    if(index >= size)
+      throw std::out_of_range("Attempt to erase out of sequence range");
+    Type item = eraseFrom(root, height, index);
+    --size;
+    shrinkRoot();
+    return item;
+  }
+
+  void erase(const const_iterator& position) {
+    if(isEmpty())
+      throw std::out_of_range("attempt to erase empty sequence");
+    if(position.index >= size)
+      throw std::out_of_range("attempt to erase at end iterator");
+    erase(position.index);
+  }
+
+  // Cuts the range out with two splits and a concat, O(log n).
+  void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded) {
+    if(isEmpty())
+      throw std::out_of_range("attempt to erase empty sequence");
+    if(firstIncluded.index > lastExcluded.index || lastExcluded.index > size)
+      throw std::out_of_range("Attempt to erase out of sequence range");
+    BTreeSequence tail = split(lastExcluded.index);
+    split(firstIncluded.index);
+    concat(std::move(tail));
+  }
+
+  Type popFirst() {
+    if(isEmpty())
+      throw std::logic_error("Attempt to pop first in empty sequence");
+    return erase(0);
+  }
+
+  Type popLast() {
+    if(isEmpty())
+      throw std::logic_error("Attempt to pop last in empty sequence");
+    return erase(size - 1);
+  }
+
+  // Appends all elements of other, which is left empty.
+  void concat(BTreeSequence&& other) {
+    if(&other == this)
+      throw std::logic_error("Attempt to concatenate sequence with itself");
+    if(other.isEmpty())
+      return;
+    if(isEmpty()) {
+      swap(other);
+      return;
+    }
+    last->next = other.first;
+    other.first->previous = last;
+    last = other.last;
+    size += other.size;
+    Node* sibling;
+    if(height >= other.height)
+      sibling = attach(root, height, other.root, other.height, true);
+    else {
+      sibling = attach(other.root, other.height, root, height, false);
+      root = other.root;
+      height = other.height;
+    }
+    if(sibling)
+      growRoot(sibling);
+    shrinkRoot();
+    other.release();
+  }
+
+  // Keeps [0, index) and returns [index, size) as a new sequence.
+  BTreeSequence split(size_type index) {
+    if(index > size)
+      throw std::out_of_range("Attempt to split out of sequence range");
+    BTreeSequence right;
+    if(index == size)
+      return right;
+    if(index == 0) {
+      swap(right);
+      return right;
+    }
+    BTreeSequence left;
+    splitNode(root, height, index, left, right);
+    release(); // the nodes now belong to left and right
+    swap(left);
+    return right;
+  }
+
+  iterator begin() {
+    return iterator(cbegin());
+  }
+
+  iterator end() {
+    return iterator(cend());
+  }
+
+  const_iterator cbegin() const {
+    return const_iterator(this, first, 0, 0);
+  }
+
+  const_iterator cend() const {
+    return const_iterator(this, last, last->count, size);
+  }
+
+  const_iterator begin() const {
+    return cbegin();
+  }
+
+  const_iterator end() const {
+    return cend();
+  }
+
+private:
+  static const size_type MIN_LEAF = LEAF_CAPACITY / 2;
+  static const size_type MIN_BRANCH = BRANCH / 2;
+
+  struct Node {
+    size_type count; // elements in a leaf, children in an inner node
+  };
+
+  struct Leaf : Node {
+    Leaf* previous;
+    Leaf* next;
+    Type items[LEAF_CAPACITY];
+
+    Leaf() : previous(nullptr), next(nullptr) {
+      this->count = 0;
+    }
+  };
+
+  struct Inner : Node {
+    size_type sizes[BRANCH + 1]; // elements under each child; one spare slot before a split
+    Node* children[BRANCH + 1];
+
+    Inner() {
+      this->count = 0;
+    }
+  };
+
+  static Leaf* asLeaf(Node* node) {
+    return static_cast<Leaf*>(node);
+  }
+
+  static Inner* asInner(Node* node) {
+    return static_cast<Inner*>(node);
+  }
+
+  static void destroy(Node* node, size_type level) {
+    if(!node)
+      return;
+    if(level == 0) {
+      delete asLeaf(node);
+      return;
+    }
+    Inner* inner = asInner(node);
+    for(size_type i = 0; i < inner->count; ++i)
+      destroy(inner->children[i], level - 1);
+    delete inner;
+  }
+
+  static size_type weight(Node* node, size_type level) {
+    if(level == 0)
+      return node->count;
+    size_type total = 0;
+    for(size_type i = 0; i < node->count; ++i)
+      total += asInner(node)->sizes[i];
+    return total;
+  }
+
+  static size_type minimum(size_type level) {
+    if(level == 0)
+      return MIN_LEAF;
+    return MIN_BRANCH;
+  }
+
+  static size_type capacity(size_type level) {
+    if(level == 0)
+      return LEAF_CAPACITY;
+    return BRANCH;
+  }
+
+  // Forgets the nodes without freeing them; they must have been handed over.
+  void release() {
+    root = new Leaf();
+    first = last = asLeaf(root);
+    height = 0;
+    size = 0;
+  }
+
+  void swap(BTreeSequence& other) {
+    std::swap(root, other.root);
+    std::swap(first, other.first);
+    std::swap(last, other.last);
+    std::swap(height, other.height);
+    std::swap(size, other.size);
+  }
+
+  // Turns offset from an index into the offset within the returned leaf.
+  const Leaf* leafFor(size_type& offset) const {
+    Node* node = root;
+    for(size_type level = height; level > 0; --level) {
+      Inner* inner = asInner(node);
+      size_type i = 0;
+      while(offset >= inner->sizes[i]) {
+        offset -= inner->sizes[i];
+        ++i;
+      }
+      node = inner->children[i];
+    }
+    return asLeaf(node);
+  }
+
+  void growRoot(Node* sibling) {
+    Inner* top = new Inner();
+    top->children[0] = root;
+    top->sizes[0] = weight(root, height);
+    top->children[1] = sibling;
+    top->sizes[1] = weight(sibling, height);
+    top->count = 2;
+    root = top;
+    ++height;
+  }
+
+  void shrinkRoot() {
+    while(height > 0 && root->count == 1) {
+      Inner* top = asInner(root);
+      root = top->children[0];
+      delete top;
+      --height;
+    }
+  }
+
+  static void insertChild(Inner* inner, size_type position, Node* child, size_type childSize) {
+    for(size_type i = inner->count; i > position; --i) {
+      inner->children[i] = inner->children[i - 1];
+      inner->sizes[i] = inner->sizes[i - 1];
+    }
+    inner->children[position] = child;
+    inner->sizes[position] = childSize;
+    ++inner->count;
+  }
+
+  static void removeChild(Inner* inner, size_type position) {
+    for(size_type i = position + 1; i < inner->count; ++i) {
+      inner->children[i - 1] = inner->children[i];
+      inner->sizes[i - 1] = inner->sizes[i];
+    }
+    --inner->count;
+  }
+
+  // Moves the upper half of a full leaf to a new leaf linked after it.
+  Leaf* splitLeaf(Leaf* leaf) {
+    Leaf* right = new Leaf();
+    size_type keep = leaf->count / 2;
+    for(size_type i = keep; i < leaf->count; ++i)
+      right->items[i - keep] = leaf->items[i];
+    right->count = leaf->count - keep;
+    leaf->count = keep;
+    right->next = leaf->next;
+    right->previous = leaf;
+    if(leaf->next)
+      leaf->next->previous = right;
+    else
+      last = right;
+    leaf->next = right;
+    return right;
+  }
+
+  static Inner* splitInner(Inner* inner) {
+    Inner* right = new Inner();
+    size_type keep = inner->count / 2;
+    for(size_type i = keep; i < inner->count; ++i) {
+      right->children[i - keep] = inner->children[i];
+      right->sizes[i - keep] = inner->sizes[i];
+    }
+    right->count = inner->count - keep;
+    inner->count = keep;
+    return right;
+  }
+
+  // Returns the new right sibling when node had to split, else nullptr.
+  Node* insertInto(Node* node, size_type level, size_type index, const Type& item) {
+    if(level == 0) {
+      Leaf* leaf = asLeaf(node);
+      Leaf* sibling = nullptr;
+      if(leaf->count == LEAF_CAPACITY) {
+        sibling = splitLeaf(leaf);
+        if(index > leaf->count) {
+          index -= leaf->count;
+          leaf = sibling;
+        }
+      }
+      for(size_type i = leaf->count; i > index; --i)
+        leaf->items[i] = leaf->items[i - 1];
+      leaf->items[index] = item;
+      ++leaf->count;
+      return sibling;
+    }
+    Inner* inner = asInner(node);
+    size_type i = 0;
+    while(i + 1 < inner->count && index > inner->sizes[i]) {
+      index -= inner->sizes[i];
+      ++i;
+    }
+    Node* sibling = insertInto(inner->children[i], level - 1, index, item);
+    ++inner->sizes[i];
+    if(sibling) {
+      size_type moved = weight(sibling, level - 1);
+      inner->sizes[i] -= moved;
+      insertChild(inner, i + 1, sibling, moved);
+    }
+    return inner->count > BRANCH ? splitInner(inner) : nullptr;
+  }
+
+  Type eraseFrom(Node* node, size_type level, size_type index) {
+    if(level == 0) {
+      Leaf* leaf = asLeaf(node);
+      Type item = leaf->items[index];
+      for(size_type i = index + 1; i < leaf->count; ++i)
+        leaf->items[i - 1] = leaf->items[i];
+      --leaf->count;
+      return item;
+    }
+    Inner* inner = asInner(node);
+    size_type i = 0;
+    while(index >= inner->sizes[i]) {
+      index -= inner->sizes[i];
+      ++i;
+    }
+    Type item = eraseFrom(inner->children[i], level - 1, index);
+    --inner->sizes[i];
+    if(inner->children[i]->count < minimum(level - 1))
+      rebalance(inner, level, i);
+    return item;
+  }
+
+  // Child i of parent is below half full: merge it with a neighbour when both
+  // fit in one node, otherwise share the entries of the two evenly.
+  void rebalance(Inner* parent, size_type level, size_type i) {
+    if(parent->count < 2)
+      return;
+    size_type leftIndex = i + 1 < parent->count ? i : i - 1;
+    Node* left = parent->children[leftIndex];
+    Node* right = parent->children[leftIndex + 1];
+    size_type childLevel = level - 1;
+    if(left->count + right->count <= capacity(childLevel)) {
+      merge(left, right, childLevel);
+      parent->sizes[leftIndex] += parent->sizes[leftIndex + 1];
+      removeChild(parent, leftIndex + 1);
+      return;
+    }
+    size_type target = (left->count + right->count) / 2;
+    if(childLevel == 0)
+      shareLeaves(asLeaf(left), asLeaf(right), target);
+    else
+      shareInners(asInner(left), asInner(right), target);
+    parent->sizes[leftIndex] = weight(left, childLevel);
+    parent->sizes[leftIndex + 1] = weight(right, childLevel);
+  }
+
+  void merge(Node* left, Node* right, size_type level) {
+    if(level == 0) {
+      Leaf* l = asLeaf(left);
+      Leaf* r = asLeaf(right);
+      for(size_type i = 0; i < r->count; ++i)
+        l->items[l->count + i] = r->items[i];
+      l->count += r->count;
+      l->next = r->next;
+      if(r->next)
+        r->next->previous = l;
+      else
+        last = l;
+      delete r;
+      return;
+    }
+    Inner* l = asInner(left);
+    Inner* r = asInner(right);
+    for(size_type i = 0; i < r->count; ++i) {
+      l->children[l->count + i] = r->children[i];
+      l->sizes[l->count + i] = r->sizes[i];
+    }
+    l->count += r->count;
+    delete r;
+  }
+
+  // Leaves left with target entries and right with the rest.
+  static void shareLeaves(Leaf* left, Leaf* right, size_type target) {
+    if(left->count > target) {
+      size_type moved = left->count - target;
+      for(size_type i = right->count; i > 0; --i)
+        right->items[i - 1 + moved] = right->items[i - 1];
+      for(size_type i = 0; i < moved; ++i)
+        right->items[i] = left->items[target + i];
+      right->count += moved;
+      left->count = target;
+    }
+    else {
+      size_type moved = target - left->count;
+      for(size_type i = 0; i < moved; ++i)
+        left->items[left->count + i] = right->items[i];
+      for(size_type i = moved; i < right->count; ++i)
+        right->items[i - moved] = right->items[i];
+      left->count = target;
+      right->count -= moved;
+    }
+  }
+
+  static void shareInners(Inner* left, Inner* right, size_type target) {
+    if(left->count > target) {
+      size_type moved = left->count - target;
+      for(size_type i = right->count; i > 0; --i) {
+        right->children[i - 1 + moved] = right->children[i - 1];
+        right->sizes[i - 1 + moved] = right->sizes[i - 1];
+      }
+      for(size_type i = 0; i < moved; ++i) {
+        right->children[i] = left->children[target + i];
+        right->sizes[i] = left->sizes[target + i];
+      }
+      right->count += moved;
+      left->count = target;
+    }
+    else {
+      size_type moved = target - left->count;
+      for(size_type i = 0; i < moved; ++i) {
+        left->children[left->count + i] = right->children[i];
+        left->sizes[left->count + i] = right->sizes[i];
+      }
+      for(size_type i = moved; i < right->count; ++i) {
+        right->children[i - moved] = right->children[i];
+        right->sizes[i - moved] = right->sizes[i];
+      }
+      left->count = target;
+      right->count -= moved;
+    }
+  }
+
+  // Hangs sub (a whole tree no taller than node) off the right edge of node,
+  // or the left edge when back is false, at the level where the heights
+  // match. Returns the new right sibling when node had to split.
+  Node* attach(Node* node, size_type level, Node* sub, size_type subLevel, bool back) {
+    if(level == subLevel) {
+      // Only reached for trees of equal height; the caller grows the root.
+      Inner* top = new Inner();
+      top->children[0] = back ? node : sub;
+      top->children[1] = back ? sub : node;
+      top->sizes[0] = weight(top->children[0], level);
+      top->sizes[1] = weight(top->children[1], level);
+      top->count = 2;
+      fixEdge(top, level + 1, back ? 1 : 0);
+      root = top;
+      height = level + 1;
+      return nullptr;
+    }
+    Inner* inner = asInner(node);
+    if(level == subLevel + 1) {
+      size_type position = back ? inner->count : 0;
+      insertChild(inner, position, sub, weight(sub, subLevel));
+      fixEdge(inner, level, position);
+    }
+    else {
+      size_type i = back ? inner->count - 1 : 0;
+      Node* sibling = attach(inner->children[i], level - 1, sub, subLevel, back);
+      inner->sizes[i] = weight(inner->children[i], level - 1);
+      if(sibling)
+        insertChild(inner, i + 1, sibling, weight(sibling, level - 1));
+    }
+    return inner->count > BRANCH ? splitInner(inner) : nullptr;
+  }
+
+  // The child at position came from another tree's root and may be below half
+  // full; so may its neighbour when both were roots.
+  void fixEdge(Inner* parent, size_type level, size_type position) {
+    size_type neighbour = position ? position - 1 : position + 1;
+    if(parent->children[position]->count < minimum(level - 1))
+      rebalance(parent, level, position);
+    else if(parent->children[neighbour]->count < minimum(level - 1))
+      rebalance(parent, level, neighbour);
+  }
+
+  // Wraps children [from, to) of an inner node as a standalone tree.
+  static void adopt(BTreeSequence& tree, Inner* inner, size_type level, size_type from, size_type to) {
+    if(from == to)
+      return;
+    delete asLeaf(tree.root);
+    if(to - from == 1) {
+      tree.root = inner->children[from];
+      tree.height = level - 1;
+      tree.size = inner->sizes[from];
+    }
+    else {
+      Inner* top = new Inner();
+      tree.size = 0;
+      for(size_type i = from; i < to; ++i) {
+        top->children[top->count] = inner->children[i];
+        top->sizes[top->count++] = inner->sizes[i];
+        tree.size += inner->sizes[i];
+      }
+      tree.root = top;
+      tree.height = level;
+    }
+    tree.findEdges();
+  }
+
+  void findEdges() {
+    Node* node = root;
+    for(size_type level = height; level > 0; --level)
+      node = asInner(node)->children[0];
+    first = asLeaf(node);
+    first->previous = nullptr;
+    node = root;
+    for(size_type level = height; level > 0; --level)
+      node = asInner(node)->children[node->count - 1];
+    last = asLeaf(node);
+    last->next = nullptr;
+  }
+
+  // Distributes the subtree at node between left ([0, index)) and right;
+  // both start empty. The subtrees beside the path are joined back with
+  // concat, lowest first, so the whole split stays O(log n).
+  static void splitNode(Node* node, size_type level, size_type index, BTreeSequence& left,
+                        BTreeSequence& right) {
+    if(level == 0) {
+      Leaf* leaf = asLeaf(node);
+      Leaf* tail = new Leaf();
+      for(size_type i = index; i < leaf->count; ++i)
+        tail->items[i - index] = leaf->items[i];
+      tail->count = leaf->count - index;
+      leaf->count = index;
+      takeLeaf(left, leaf);
+      takeLeaf(right, tail);
+      return;
+    }
+    Inner* inner = asInner(node);
+    size_type i = 0;
+    while(index >= inner->sizes[i]) {
+      index -= inner->sizes[i];
+      ++i;
+    }
+    BTreeSequence childLeft, childRight;
+    splitNode(inner->children[i], level - 1, index, childLeft, childRight);
+    adopt(left, inner, level, 0, i);
+    adopt(right, inner, level, i + 1, inner->count);
+    delete inner;
+    left.concat(std::move(childLeft));
+    childRight.concat(std::move(right));
+    right.swap(childRight);
+  }
+
+  static void takeLeaf(BTreeSequence& tree, Leaf* leaf) {
+    if(!leaf->count) {
+      delete leaf;
+      return;
+    }
+    delete asLeaf(tree.root);
+    leaf->previous = leaf->next = nullptr;
+    tree.root = tree.first = tree.last = leaf;
+    tree.height = 0;
+    tree.size = leaf->count;
+  }
+
+  // Position of index as a leaf and an offset, index == size gives the end.
+  void locate(size_type index, const Leaf*& leaf, size_type& offset) const {
+    if(index == size) {
+      leaf = last;
+      offset = last->count;
+      return;
+    }
+    offset = index;
+    leaf = leafFor(offset);
+  }
+
+  Node* root;
+  Leaf* first;
+  Leaf* last;
+  size_type height;
+  size_type size;
+};
+
+template <typename Type>
+class BTreeSequence<Type>::ConstIterator
+{
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename BTreeSequence::value_type;
+  using difference_type = typename BTreeSequence::difference_type;
+  using pointer = typename BTreeSequence::const_pointer;
+  using reference = typename BTreeSequence::const_reference;
+
+  ConstIterator() : seq(nullptr), leaf(nullptr), offset(0), index(0) {}
+
+  ConstIterator(const BTreeSequence* s, const Leaf* l, size_type o, size_type i)
+    : seq(s), leaf(l), offset(o), index(i) {}
+
+  reference operator*() const {
+    if(index >= seq->size)
+      throw std::out_of_range("Attempt to dereference end iterator");
+    return leaf->items[offset];
+  }
+
+  ConstIterator& operator++() {
+    if(index == seq->size)
+      throw std::out_of_range("Attempt to increment end iterator");
+    ++index;
+    if(++offset == leaf->count && leaf->next) {
+      leaf = leaf->next;
+      offset = 0;
+    }
+    return *this;
+  }
+
+  ConstIterator operator++(int) {
+    ConstIterator result = *this;
+    operator++();
+    return result;
+  }
+
+  ConstIterator& operator--() {
+    if(index == 0)
+      throw std::out_of_range("Attempt to decrement begin iterator");
+    --index;
+    if(offset == 0) {
+      leaf = leaf->previous;
+      offset = leaf->count;
+    }
+    --offset;
+    return *this;
+  }
+
+  ConstIterator operator--(int) {
+    ConstIterator result = *this;
+    operator--();
+    return result;
+  }
+
+  ConstIterator operator+(difference_type d) const {
+    if(d < 0)
+      return operator-(-d);
+    if(index + d > seq->size)
+      throw std::out_of_range("Attempt to add out of sequence range");
+    ConstIterator result(seq, nullptr, 0, index + d);
+    seq->locate(result.index, result.leaf, result.offset);
+    return result;
+  }
+
+  ConstIterator operator-(difference_type d) const {
+    if(d < 0)
+      return operator+(-d);
+    if(d > static_cast<difference_type>(index))
+      throw std::out_of_range("Attempt to substract out of sequence range");
+    ConstIterator result(seq, nullptr, 0, index - d);
+    seq->locate(result.index, result.leaf, result.offset);
+    return result;
+  }
+
+  bool operator==(const ConstIterator& other) const {
+    return seq == other.seq && index == other.index;
+  }
+
+  bool operator!=(const ConstIterator& other) const {
+    return !operator==(other);
+  }
+
+protected:
+  const BTreeSequence* seq;
+  const Leaf* leaf;
+  size_type offset;
+  size_type index;
+
+  friend class BTreeSequence;
+};
+
+template <typename Type>
+class BTreeSequence<Type>::Iterator : public BTreeSequence<Type>::ConstIterator
+{
+public:
+  using pointer = typename BTreeSequence::pointer;
+  using reference = typename BTreeSequence::reference;
+
+  Iterator() {}
+
+  Iterator(const ConstIterator& other)
+    : ConstIterator(other) {}
+
+  Iterator& operator++() {
+    ConstIterator::operator++();
+    return *this;
+  }
+
+  Iterator operator++(int) {
+    auto result = *this;
+    ConstIterator::operator++();
+    return result;
+  }
+
+  Iterator& operator--() {
+    ConstIterator::operator--();
+    return *this;
+  }
+
+  Iterator operator--(int) {
+    auto result = *this;
+    ConstIterator::operator--();
+    return result;
+  }
+
+  Iterator operator+(difference_type d) const {
+    return ConstIterator::operator+(d);
+  }
+
+  Iterator operator-(difference_type d) const {
+    return ConstIterator::operator-(d);
+  }
+
+  reference operator*() const {
+    // ugly cast, yet reduces code duplication.
+    return const_cast<reference>(ConstIterator::operator*());
+  }
+};
+
+}
+
+#endif // AISDI_LINEAR_BTREESEQUENCE_H
@@ -0,0 +1,460 @@
+#ifndef AISDI_LINEAR_BENCHMARK_H
+#define AISDI_LINEAR_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "LatencyHistogram.h"
+#include "PerfCounters.h"
+
+// Timing harness for the aisdiLinearBench target. Every round gets a fresh
+// fixture from an untimed setup, then a timed body performs a known number of
+// operations; rounds are summarized as median and p99 nanoseconds per
+// operation. With hardware counters, a few extra rounds are counted (never
+// timed) and reported per operation as well. The latency mode times single
+// operations (or small batches) into a LatencyHistogram, so rare spikes show
+// up in the tail. The memory mode measures resident set growth instead, each
+// container built in a forked child. Replayed traces are timed like the
+// synthetic operations and reported as throughput.
+
+namespace aisdi
+{
+namespace bench
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  std::vector<std::size_t> sizes { 10, 1000, 100000, 1000000 };
+  std::size_t warmup = 1;               // untimed rounds before measuring
+  std::size_t minRepetitions = 5;
+  std::size_t maxRepetitions = 1000;
+  std::size_t targetOps = 1000000;      // operations per size, spread over rounds
+  std::size_t maxQuadraticSize = 10000; // largest size for O(n) per op cases
+  PerfCounters* counters = nullptr;     // counted rounds are skipped without it
+  std::size_t latencyBatch = 1;         // operations per timed sample in latency mode
+};
+
+const std::size_t COUNTED_ROUNDS = 5;
+
+struct Timing {
+  std::size_t repetitions;
+  double medianNs;
+  double p99Ns;
+  double minNs;
+  PerfCounters::Sample perOp; // medians of the counted rounds
+};
+
+struct Result {
+  std::string container;
+  std::string type;
+  std::string operation;
+  std::size_t size;
+  Timing timing;
+};
+
+struct LatencyResult {
+  std::string container;
+  std::string type;
+  std::string operation;
+  std::size_t size;
+  std::size_t batch;
+  LatencyHistogram histogram; // nanoseconds per operation
+};
+
+// Percentiles reported for latency results, also used as column names.
+const double LATENCY_PERCENTILES[] = { 50, 90, 99, 99.9 };
+
+struct MemoryResult {
+  std::string container;
+  std::string type;
+  std::size_t size;
+  double residentBytes;  // RSS growth while the container was built
+  double estimatedBytes; // memoryUsage().totalBytes(), negative when unknown
+};
+
+// Keeps the compiler from dropping computations whose result is unused.
+template <typename Type>
+inline void doNotOptimize(const Type& value) {
+  asm volatile("" : : "m"(value) : "memory");
+}
+
+// Nearest-rank percentile of sorted samples.
+inline double percentile(const std::vector<double>& sorted, double fraction) {
+  std::size_t rank = static_cast<std::size_t>(fraction * sorted.size() + 0.999999);
+  return sorted[rank ? rank - 1 : 0];
+}
+
+// "99.9" for 99.9, "50" for 50; used in column names.
+inline std::string formatPercentile(double p) {
+  std::string text = std::to_string(p);
+  text.erase(text.find_last_not_of('0') + 1);
+  if(text.back() == '.')
+    text.pop_back();
+  return text;
+}
+
+inline bool hasCounters(const std::vector<Result>& results) {
+  for(const Result& r : results)
+    if(!r.timing.perOp.isEmpty())
+      return true;
+  return false;
+}
+
+inline std::size_t repetitionsFor(const Options& options, std::size_t opsPerRound) {
+  std::size_t rounds = options.targetOps / (opsPerRound ? opsPerRound : 1);
+  return std::min(std::max(rounds, options.minRepetitions), options.maxRepetitions);
+}
+
+template <typename Setup, typename Body>
+PerfCounters::Sample count(PerfCounters& counters, std::size_t rounds, std::size_t opsPerRound,
+                           Setup& setup, Body& body) {
+  std::vector<double> perEvent[PerfCounters::EVENT_COUNT];
+  for(std::size_t i = 0; i < rounds; ++i) {
+    auto fixture = setup();
+    counters.start();
+    body(fixture);
+    PerfCounters::Sample sample = counters.stop();
+    for(int e = 0; e < PerfCounters::EVENT_COUNT; ++e)
+      if(sample.valid[e])
+        perEvent[e].push_back(sample.values[e] / (opsPerRound ? opsPerRound : 1));
+  }
+  PerfCounters::Sample result;
+  for(int e = 0; e < PerfCounters::EVENT_COUNT; ++e) {
+    if(perEvent[e].empty())
+      continue;
+    std::sort(perEvent[e].begin(), perEvent[e].end());
+    result.values[e] = percentile(perEvent[e], 0.5);
+    result.valid[e] = true;
+  }
+  return result;
+}
+
+// setup() builds the fixture outside the timed region; body(fixture) runs
+// opsPerRound operations on it. The fixture is destroyed untimed as well.
+template <typename Setup, typename Body>
+Timing measure(const Options& options, std::size_t opsPerRound, Setup setup, Body body) {
+  for(std::size_t i = 0; i < options.warmup; ++i) {
+    auto fixture = setup();
+    body(fixture);
+  }
+  std::size_t repetitions = repetitionsFor(options, opsPerRound);
+  std::vector<double> samples;
+  samples.reserve(repetitions);
+  for(std::size_t i = 0; i < repetitions; ++i) {
+    auto fixture = setup();
+    Clock::time_point start = Clock::now();
+    body(fixture);
+    Clock::time_point stop = Clock::now();
+    std::chrono::duration<double, std::nano> elapsed = stop - start;
+    samples.push_back(elapsed.count() / (opsPerRound ? opsPerRound : 1));
+  }
+  std::sort(samples.begin(), samples.end());
+  Timing timing;
+  timing.repetitions = repetitions;
+  timing.medianNs = percentile(samples, 0.5);
+  timing.p99Ns = percentile(samples, 0.99);
+  timing.minNs = samples.front();
+  if(options.counters && options.counters->isAvailable())
+    timing.perOp = count(*options.counters, std::min(repetitions, COUNTED_ROUNDS), opsPerRound, setup, body);
+  return timing;
+}
+
+// Like measure(), but body(fixture, i) performs operation i alone and every
+// batch of options.latencyBatch operations is timed on its own. A sample is
+// the batch time divided by its length, so a batch above 1 trades tail
+// resolution for less clock overhead.
+template <typename Setup, typename Body>
+LatencyHistogram measureLatency(const Options& options, std::size_t opsPerRound, Setup setup, Body body) {
+  std::size_t batch = options.latencyBatch ? options.latencyBatch : 1;
+  for(std::size_t r = 0; r < options.warmup; ++r) {
+    auto fixture = setup();
+    for(std::size_t i = 0; i < opsPerRound; ++i)
+      body(fixture, i);
+  }
+  LatencyHistogram histogram;
+  std::size_t repetitions = repetitionsFor(options, opsPerRound);
+  for(std::size_t r = 0; r < repetitions; ++r) {
+    auto fixture = setup();
+    for(std::size_t first = 0; first < opsPerRound; first += batch) {
+      std::size_t last = std::min(first + batch, opsPerRound);
+      Clock::time_point start = Clock::now();
+      for(std::size_t i = first; i < last; ++i)
+        body(fixture, i);
+      Clock::time_point stop = Clock::now();
+      std::uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+      std::uint64_t length = last - first;
+      histogram.record((elapsed + length / 2) / length);
+    }
+  }
+  return histogram;
+}
+
+inline void printLatencyTable(std::ostream& out, const std::vector<LatencyResult>& results) {
+  out << std::left << std::setw(12) << "container" << std::setw(16) << "type" << std::setw(14) << "operation"
+      << std::right << std::setw(11) << "size" << std::setw(7) << "batch" << std::setw(12) << "samples";
+  for(double p : LATENCY_PERCENTILES)
+    out << std::setw(10) << ("p" + formatPercentile(p));
+  out << std::setw(12) << "max" << std::setw(10) << "mean" << "  (ns/op)\n";
+  for(const LatencyResult& r : results) {
+    out << std::left << std::setw(12) << r.container << std::setw(16) << r.type << std::setw(14) << r.operation
+        << std::right << std::setw(11) << r.size << std::setw(7) << r.batch
+        << std::setw(12) << r.histogram.count();
+    for(double p : LATENCY_PERCENTILES)
+      out << std::setw(10) << r.histogram.valueAtPercentile(p);
+    out << std::setw(12) << r.histogram.max() << std::setw(10) << static_cast<std::uint64_t>(r.histogram.mean() + 0.5)
+        << '\n';
+  }
+}
+
+inline void writeLatencyCsv(std::ostream& out, const std::vector<LatencyResult>& results) {
+  out << "container,type,operation,size,batch,samples";
+  for(double p : LATENCY_PERCENTILES)
+    out << ",p" << formatPercentile(p) << "_ns";
+  out << ",max_ns,mean_ns\n";
+  for(const LatencyResult& r : results) {
+    out << r.container << ',' << r.type << ',' << r.operation << ',' << r.size << ',' << r.batch << ','
+        << r.histogram.count();
+    for(double p : LATENCY_PERCENTILES)
+      out << ',' << r.histogram.valueAtPercentile(p);
+    out << ',' << r.histogram.max() << ',' << r.histogram.mean() << '\n';
+  }
+}
+
+inline void writeLatencyJson(std::ostream& out, const std::vector<LatencyResult>& results) {
+  out << "[\n";
+  for(std::size_t i = 0; i < results.size(); ++i) {
+    const LatencyResult& r = results[i];
+    out << "  {\"container\": \"" << r.container << "\", \"type\": \"" << r.type
+        << "\", \"operation\": \"" << r.operation << "\", \"size\": " << r.size
+        << ", \"batch\": " << r.batch << ", \"samples\": " << r.histogram.count();
+    for(double p : LATENCY_PERCENTILES)
+      out << ", \"p" << formatPercentile(p) << "_ns\": " << r.histogram.valueAtPercentile(p);
+    out << ", \"max_ns\": " << r.histogram.max() << ", \"mean_ns\": " << r.histogram.mean() << '}'
+        << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  out << "]\n";
+}
+
+// One row per non-empty bucket with the fraction of samples at or below it,
+// ready for a CDF or percentile plot (log scale on the latency axis).
+inline void writeDistribution(std::ostream& out, const std::vector<LatencyResult>& results) {
+  out << "container,type,operation,size,low_ns,high_ns,count,cumulative_fraction\n";
+  for(const LatencyResult& r : results) {
+    std::uint64_t seen = 0;
+    for(std::size_t b = 0; seen < r.histogram.count(); ++b) {
+      std::uint64_t n = r.histogram.countAt(b);
+      if(!n)
+        continue;
+      seen += n;
+      out << r.container << ',' << r.type << ',' << r.operation << ',' << r.size << ','
+          << LatencyHistogram::lowestEquivalent(b) << ',' << LatencyHistogram::highestEquivalent(b) << ','
+          << n << ',' << static_cast<double>(seen) / r.histogram.count() << '\n';
+    }
+  }
+}
+
+inline double residentBytes() {
+  std::FILE* statm = std::fopen("/proc/self/statm", "r");
+  if(!statm)
+    throw std::runtime_error("Cannot read /proc/self/statm");
+  unsigned long pages = 0, resident = 0;
+  int fields = std::fscanf(statm, "%lu %lu", &pages, &resident);
+  std::fclose(statm);
+  if(fields != 2)
+    throw std::runtime_error("Unexpected /proc/self/statm format");
+  return static_cast<double>(resident) * ::sysconf(_SC_PAGESIZE);
+}
+
+// Runs build() in a forked child, so memory kept by the allocator after
+// earlier containers cannot hide this one's growth. build() returns the
+// container's own estimate (negative when it has none) and must keep the
+// container alive until then; the child reports both numbers through a pipe.
+template <typename Build>
+MemoryResult measureResident(std::size_t size, Build build) {
+  int channel[2];
+  if(::pipe(channel) != 0)
+    throw std::runtime_error("pipe failed");
+  pid_t child = ::fork();
+  if(child < 0)
+    throw std::runtime_error("fork failed");
+  if(child == 0) {
+    ::close(channel[0]);
+    double numbers[2] = { -1, -1 };
+    try {
+      double before = residentBytes();
+      numbers[1] = build(numbers[0]);
+      numbers[0] -= before;
+    }
+    catch(...) {
+      numbers[0] = -1;
+    }
+    ssize_t written = ::write(channel[1], numbers, sizeof(numbers));
+    ::_exit(written == sizeof(numbers) ? 0 : 1);
+  }
+  ::close(channel[1]);
+  double numbers[2];
+  ssize_t got = ::read(channel[0], numbers, sizeof(numbers));
+  ::close(channel[0]);
+  int status = 0;
+  ::waitpid(child, &status, 0);
+  if(got != sizeof(numbers) || numbers[0] < 0)
+    throw std::runtime_error("memory measurement failed");
+  MemoryResult result;
+  result.size = size;
+  result.residentBytes = numbers[0];
+  result.estimatedBytes = numbers[1];
+  return result;
+}
+
+inline void printMemoryTable(std::ostream& out, const std::vector<MemoryResult>& results) {
+  std::ios::fmtflags flags = out.flags();
+  std::streamsize precision = out.precision();
+  out << std::left << std::setw(12) << "container" << std::setw(16) << "type" << std::right
+      << std::setw(11) << "size" << std::setw(16) << "RSS MB/million" << std::setw(12) << "RSS B/elem"
+      << std::setw(14) << "estim. B/elem" << '\n';
+  for(const MemoryResult& r : results) {
+    double perElement = r.residentBytes / (r.size ? r.size : 1);
+    out << std::left << std::setw(12) << r.container << std::setw(16) << r.type << std::right
+        << std::setw(11) << r.size << std::fixed << std::setprecision(2)
+        << std::setw(16) << perElement * 1e6 / (1 << 20) << std::setw(12) << perElement << std::setw(14);
+    if(r.estimatedBytes < 0)
+      out << '-';
+    else
+      out << r.estimatedBytes / (r.size ? r.size : 1);
+    out << '\n';
+  }
+  out.flags(flags);
+  out.precision(precision);
+}
+
+inline void writeMemoryCsv(std::ostream& out, const std::vector<MemoryResult>& results) {
+  out << "container,type,size,rss_bytes,rss_bytes_per_million,estimated_bytes\n";
+  for(const MemoryResult& r : results) {
+    out << r.container << ',' << r.type << ',' << r.size << ',' << r.residentBytes << ','
+        << r.residentBytes * 1e6 / (r.size ? r.size : 1) << ',';
+    if(r.estimatedBytes >= 0)
+      out << r.estimatedBytes;
+    out << '\n';
+  }
+}
+
+inline void writeMemoryJson(std::ostream& out, const std::vector<MemoryResult>& results) {
+  out << "[\n";
+  for(std::size_t i = 0; i < results.size(); ++i) {
+    const MemoryResult& r = results[i];
+    out << "  {\"container\": \"" << r.container << "\", \"type\": \"" << r.type
+        << "\", \"size\": " << r.size << ", \"rss_bytes\": " << r.residentBytes
+        << ", \"rss_bytes_per_million\": " << r.residentBytes * 1e6 / (r.size ? r.size : 1);
+    if(r.estimatedBytes >= 0)
+      out << ", \"estimated_bytes\": " << r.estimatedBytes;
+    out << '}' << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  out << "]\n";
+}
+
+inline void printTable(std::ostream& out, const std::vector<Result>& results) {
+  std::ios::fmtflags flags = out.flags();
+  std::streamsize precision = out.precision();
+  out << std::left << std::setw(12) << "container" << std::setw(14) << "type"
+      << std::setw(14) << "operation" << std::right << std::setw(11) << "size"
+      << std::setw(8) << "rounds" << std::setw(14) << "median ns/op" << std::setw(12) << "p99 ns/op";
+  bool counters = hasCounters(results);
+  if(counters)
+    for(int e = 0; e < PerfCounters::EVENT_COUNT; ++e)
+      out << std::setw(15) << PerfCounters::eventName(static_cast<PerfCounters::Event>(e));
+  out << '\n';
+  for(const Result& r : results) {
+    out << std::left << std::setw(12) << r.container << std::setw(14) << r.type
+        << std::setw(14) << r.operation << std::right << std::setw(11) << r.size
+        << std::setw(8) << r.timing.repetitions << std::fixed << std::setprecision(2)
+        << std::setw(14) << r.timing.medianNs << std::setw(12) << r.timing.p99Ns;
+    for(int e = 0; counters && e < PerfCounters::EVENT_COUNT; ++e) {
+      out << std::setw(15);
+      if(r.timing.perOp.valid[e])
+        out << r.timing.perOp.values[e];
+      else
+        out << '-';
+    }
+    out << '\n';
+  }
+  out.flags(flags);
+  out.precision(precision);
+}
+
+// For replayed traces: the median round as operations per second.
+inline void printThroughputTable(std::ostream& out, const std::vector<Result>& results) {
+  std::ios::fmtflags flags = out.flags();
+  std::streamsize precision = out.precision();
+  out << std::left << std::setw(12) << "container" << std::setw(16) << "type" << std::right
+      << std::setw(11) << "events" << std::setw(8) << "rounds" << std::setw(14) << "median ns/op"
+      << std::setw(12) << "Mops/s" << '\n';
+  for(const Result& r : results) {
+    out << std::left << std::setw(12) << r.container << std::setw(16) << r.type << std::right
+        << std::setw(11) << r.size << std::setw(8) << r.timing.repetitions << std::fixed << std::setprecision(2)
+        << std::setw(14) << r.timing.medianNs << std::setw(12)
+        << (r.timing.medianNs > 0 ? 1e3 / r.timing.medianNs : 0) << '\n';
+  }
+  out.flags(flags);
+  out.precision(precision);
+}
+
+// Counter columns are always present and left empty when not measured.
+inline void writeCsv(std::ostream& out, const std::vector<Result>& results) {
+  out << "container,type,operation,size,repetitions,median_ns,p99_ns,min_ns";
+  for(int e = 0; e < PerfCounters::EVENT_COUNT; ++e)
+    out << ',' << PerfCounters::eventName(static_cast<PerfCounters::Event>(e));
+  out << '\n';
+  for(const Result& r : results) {
+    out << r.container << ',' << r.type << ',' << r.operation << ',' << r.size << ','
+        << r.timing.repetitions << ',' << r.timing.medianNs << ',' << r.timing.p99Ns << ','
+        << r.timing.minNs;
+    for(int e = 0; e < PerfCounters::EVENT_COUNT; ++e) {
+      out << ',';
+      if(r.timing.perOp.valid[e])
+        out << r.timing.perOp.values[e];
+    }
+    out << '\n';
+  }
+}
+
+// Names are plain identifiers, so no string escaping is needed.
+inline void writeJson(std::ostream& out, const std::vector<Result>& results) {
+  out << "[\n";
+  for(std::size_t i = 0; i < results.size(); ++i) {
+    const Result& r = results[i];
+    out << "  {\"container\": \"" << r.container << "\", \"type\": \"" << r.type
+        << "\", \"operation\": \"" << r.operation << "\", \"size\": " << r.size
+        << ", \"repetitions\": " << r.timing.repetitions << ", \"median_ns\": " << r.timing.medianNs
+        << ", \"p99_ns\": " << r.timing.p99Ns << ", \"min_ns\": " << r.timing.minNs;
+    if(!r.timing.perOp.isEmpty()) {
+      out << ", \"per_op\": {";
+      const char* separator = "";
+      for(int e = 0; e < PerfCounters::EVENT_COUNT; ++e)
+        if(r.timing.perOp.valid[e]) {
+          out << separator << '"' << PerfCounters::eventName(static_cast<PerfCounters::Event>(e))
+              << "\": " << r.timing.perOp.values[e];
+          separator = ", ";
+        }
+      out << '}';
+    }
+    out << '}' << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  out << "]\n";
+}
+
+}
+}
+
+#endif // AISDI_LINEAR_BENCHMARK_H
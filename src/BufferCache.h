@@ -0,0 +1,172 @@
+#ifndef AISDI_LINEAR_BUFFERCACHE_H
+#define AISDI_LINEAR_BUFFERCACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace aisdi
+{
+
+namespace detail
+{
+struct BufferCacheHolder;
+}
+
+// Per-thread cache of freed heap buffers, consulted by detail::allocateBuffer
+// and detail::releaseBuffer, so containers created and destroyed in a loop
+// stop going to the allocator for the same 10, 20, 40... element buffers.
+// Buffers are grouped in power-of-two size classes and remembered with the
+// byte count they were released with; a request is served by a buffer of at
+// least its size and alignment from its class. The cache is off (capacity 0)
+// until setCapacity or setDefaultCapacity gives it a byte budget; buffers
+// that would exceed it are freed as before. Huge-page mappings are never
+// cached. Buffers freed on another thread land in that thread's cache.
+class BufferCache
+{
+public:
+  static const std::size_t MIN_CLASS_BITS = 6;  // 64 bytes
+  static const std::size_t MAX_CLASS_BITS = 20; // 1 MiB, larger buffers are not cached
+  static const std::size_t CLASS_COUNT = MAX_CLASS_BITS - MIN_CLASS_BITS + 1;
+
+  BufferCache(const BufferCache&) = delete;
+  BufferCache& operator=(const BufferCache&) = delete;
+
+  ~BufferCache() {
+    trim(0);
+  }
+
+  // The calling thread's cache; nullptr while the thread is being torn down.
+  static BufferCache* local();
+
+  // Budget for caches created from now on, e.g. set once before starting
+  // request handler threads.
+  static void setDefaultCapacity(std::size_t bytes) {
+    defaultCapacity().store(bytes, std::memory_order_relaxed);
+  }
+
+  // Byte budget of this thread's cache; lowering it trims right away.
+  void setCapacity(std::size_t bytes) {
+    capacity = bytes;
+    trim(bytes);
+  }
+
+  std::size_t getCapacity() const {
+    return capacity;
+  }
+
+  std::size_t cachedBytes() const {
+    return cached;
+  }
+
+  std::uint64_t hits() const {
+    return hitCount;
+  }
+
+  std::uint64_t misses() const {
+    return missCount;
+  }
+
+  // Frees cached buffers, largest classes first, until at most target bytes
+  // are left.
+  void trim(std::size_t target = 0) {
+    for(std::size_t c = CLASS_COUNT; c > 0 && cached > target; --c) {
+      std::vector<Entry>& entries = classes[c - 1];
+      while(!entries.empty() && cached > target) {
+        std::free(entries.back().buffer);
+        cached -= entries.back().bytes;
+        entries.pop_back();
+      }
+    }
+  }
+
+  // A cached buffer of at least bytes aligned to alignment, or nullptr.
+  void* acquire(std::size_t bytes, std::size_t alignment) {
+    if(!capacity || bytes > MAX_BUFFER_BYTES)
+      return nullptr;
+    std::vector<Entry>& entries = classes[classOf(bytes)];
+    for(std::size_t i = entries.size(); i > 0; --i) {
+      Entry entry = entries[i - 1];
+      if(entry.bytes < bytes || reinterpret_cast<std::uintptr_t>(entry.buffer) % alignment)
+        continue;
+      entries[i - 1] = entries.back();
+      entries.pop_back();
+      cached -= entry.bytes;
+      ++hitCount;
+      return entry.buffer;
+    }
+    ++missCount;
+    return nullptr;
+  }
+
+  // Keeps a buffer released with bytes; false if it does not fit the budget,
+  // and the caller frees it.
+  bool offer(void* buffer, std::size_t bytes) {
+    if(bytes > MAX_BUFFER_BYTES || bytes > capacity - cached)
+      return false;
+    classes[classOf(bytes)].push_back(Entry{ buffer, bytes });
+    cached += bytes;
+    return true;
+  }
+
+private:
+  static const std::size_t MAX_BUFFER_BYTES = std::size_t(1) << MAX_CLASS_BITS;
+
+  struct Entry {
+    void* buffer;
+    std::size_t bytes;
+  };
+
+  friend struct detail::BufferCacheHolder;
+
+  BufferCache() : capacity(defaultCapacity().load(std::memory_order_relaxed)), cached(0), hitCount(0),
+                  missCount(0) {}
+
+  static std::atomic<std::size_t>& defaultCapacity() {
+    static std::atomic<std::size_t> bytes(0);
+    return bytes;
+  }
+
+  static std::size_t classOf(std::size_t bytes) { // bytes <= MAX_BUFFER_BYTES
+    if(bytes <= (std::size_t(1) << MIN_CLASS_BITS))
+      return 0;
+    return 64 - __builtin_clzll(bytes - 1) - MIN_CLASS_BITS;
+  }
+
+  std::vector<Entry> classes[CLASS_COUNT];
+  std::size_t capacity;
+  std::size_t cached;
+  std::uint64_t hitCount;
+  std::uint64_t missCount;
+};
+
+namespace detail
+{
+
+// Flags the thread as finished once its cache is gone, so buffers released
+// by thread_local containers destroyed later are freed directly.
+struct BufferCacheHolder {
+  explicit BufferCacheHolder(bool& f) : finished(f) {}
+  ~BufferCacheHolder() {
+    finished = true;
+  }
+
+  BufferCache cache;
+  bool& finished;
+};
+
+}
+
+inline BufferCache* BufferCache::local() {
+  static thread_local bool finished = false;
+  if(finished)
+    return nullptr;
+  static thread_local detail::BufferCacheHolder holder(finished);
+  return &holder.cache;
+}
+
+}
+
+#endif // AISDI_LINEAR_BUFFERCACHE_H
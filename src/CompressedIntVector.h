@@ -0,0 +1,404 @@
+#ifndef AISDI_LINEAR_COMPRESSEDINTVECTOR_H
+#define AISDI_LINEAR_COMPRESSEDINTVECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Vector.h"
+
+namespace aisdi
+{
+namespace detail
+{
+
+inline unsigned bitWidth(std::uint64_t value) {
+  return value ? 64 - __builtin_clzll(value) : 0;
+}
+
+// Reads the index-th field of a packed array of bits wide fields. The word
+// after the field must be readable (packed stores keep a padding word), so a
+// field straddling two words needs no branch.
+inline std::uint64_t extractBits(const std::uint64_t* words, std::size_t index, unsigned bits) {
+  if(!bits)
+    return 0;
+  std::size_t position = index * bits;
+  unsigned shift = position % 64;
+  const std::uint64_t* word = words + position / 64;
+  std::uint64_t value = (word[0] >> shift) | ((word[1] << 1) << (63 - shift));
+  return bits == 64 ? value : value & ((std::uint64_t(1) << bits) - 1);
+}
+
+// Writes into zeroed words.
+inline void packBits(std::uint64_t* words, std::size_t index, unsigned bits, std::uint64_t value) {
+  if(!bits)
+    return;
+  std::size_t position = index * bits;
+  unsigned shift = position % 64;
+  std::uint64_t* word = words + position / 64;
+  word[0] |= value << shift;
+  if(shift + bits > 64)
+    word[1] |= value >> (64 - shift);
+}
+
+// With the width known at compile time the loop has constant shifts and
+// masks, which leaves the compiler free to unroll and vectorize it.
+template <typename Unsigned, std::size_t Count, unsigned Bits>
+void unpackBlock(const std::uint64_t* words, Unsigned base, Unsigned* out) {
+  for(std::size_t i = 0; i < Count; ++i)
+    out[i] = base + static_cast<Unsigned>(extractBits(words, i, Bits));
+}
+
+template <typename Unsigned, std::size_t Count>
+struct BlockUnpacker
+{
+  using Function = void (*)(const std::uint64_t*, Unsigned, Unsigned*);
+
+  static Function select(unsigned bits) {
+    return table(std::make_integer_sequence<unsigned, std::numeric_limits<Unsigned>::digits + 1>())[bits];
+  }
+
+private:
+  template <unsigned... Bits>
+  static const Function* table(std::integer_sequence<unsigned, Bits...>) {
+    static const Function functions[] = { &unpackBlock<Unsigned, Count, Bits>... };
+    return functions;
+  }
+};
+
+}
+
+// Append-only integer vector stored in blocks of BLOCK_SIZE values. Each full
+// block is bit-packed with frame of reference (value - block minimum) or, for
+// non-decreasing blocks where it is narrower, as deltas from the previous
+// value. A skip table gives every block's base, width and word offset, so a
+// block is found in O(1); values past the last full block wait uncompressed in
+// the tail. Scans should go through decodeBlock() or the iterators, which
+// decode a whole block at a time.
+template <typename Type>
+class CompressedIntVector
+{
+  static_assert(std::is_integral<Type>::value && !std::is_same<Type, bool>::value,
+                "CompressedIntVector can only store integers");
+
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = Type;
+  using reference = Type; // values are decoded on access, not stored
+  using const_reference = Type;
+
+  class ConstIterator;
+  using iterator = ConstIterator;
+  using const_iterator = ConstIterator;
+
+  static const size_type BLOCK_SIZE = 128;
+
+  CompressedIntVector() : size(0), unseals(0) {
+    words.append(0); // padding word, see detail::extractBits
+  }
+
+  CompressedIntVector(std::initializer_list<Type> l) : CompressedIntVector() {
+    for(auto it = l.begin(); it != l.end(); ++it)
+      append(*it);
+  }
+
+  CompressedIntVector(const CompressedIntVector& other) = default;
+
+  CompressedIntVector(CompressedIntVector&& other)
+    : words(std::move(other.words)), blocks(std::move(other.blocks)), size(other.size), unseals(0) {
+    copyTail(other);
+    //reinitialize
+    other.words.append(0);
+    other.size = 0;
+  }
+
+  CompressedIntVector& operator=(const CompressedIntVector& other) = default;
+
+  CompressedIntVector& operator=(CompressedIntVector&& other) {
+    if(this == &other)
+      return *this;
+    words = std::move(other.words);
+    blocks = std::move(other.blocks);
+    size = other.size;
+    copyTail(other);
+    other.words.append(0);
+    other.size = 0;
+    return *this;
+  }
+
+  bool isEmpty() const {
+    return !size;
+  }
+
+  size_type getSize() const {
+    return size;
+  }
+
+  // Number of blocks, counting a partially filled tail.
+  size_type blockCount() const {
+    return (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  }
+
+  // Bytes taken by packed words, the skip table and the tail buffer.
+  size_type compressedBytes() const {
+    return words.getSize() * sizeof(std::uint64_t) + blocks.getSize() * sizeof(BlockInfo) + sizeof(tail);
+  }
+
+  void append(Type item) {
+    tail[size % BLOCK_SIZE] = item;
+    if(++size % BLOCK_SIZE == 0)
+      sealTail();
+  }
+
+  Type popLast() {
+    if(isEmpty())
+      throw std::logic_error("Attempt to pop last in empty vector");
+    if(!tailSize())
+      unsealLastBlock();
+    --size;
+    return tail[size % BLOCK_SIZE];
+  }
+
+  // O(1) for frame blocks; delta blocks sum the deltas up to index.
+  Type at(size_type index) const {
+    if(index >= size)
+      throw std::out_of_range("Attempt to access out of vector range");
+    size_type block = index / BLOCK_SIZE;
+    size_type position = index % BLOCK_SIZE;
+    if(block == blocks.getSize())
+      return tail[position];
+    const BlockInfo& info = blocks.data()[block];
+    const std::uint64_t* packed = words.data() + info.offset;
+    if(info.encoding == FRAME)
+      return static_cast<Type>(info.base + static_cast<Unsigned>(detail::extractBits(packed, position, info.bits)));
+    Unsigned value = info.base;
+    for(size_type i = 1; i <= position; ++i)
+      value += static_cast<Unsigned>(detail::extractBits(packed, i, info.bits));
+    return static_cast<Type>(value);
+  }
+
+  // Decodes block into out (room for BLOCK_SIZE values), returns its length.
+  size_type decodeBlock(size_type block, Type* out) const {
+    if(block >= blockCount())
+      throw std::out_of_range("Attempt to decode out of vector range");
+    if(block == blocks.getSize()) {
+      for(size_type i = 0; i < tailSize(); ++i)
+        out[i] = tail[i];
+      return tailSize();
+    }
+    const BlockInfo& info = blocks.data()[block];
+    Unsigned* values = reinterpret_cast<Unsigned*>(out);
+    Unpacker::select(info.bits)(words.data() + info.offset, info.encoding == FRAME ? info.base : 0, values);
+    if(info.encoding == DELTA) {
+      Unsigned running = info.base;
+      for(size_type i = 0; i < BLOCK_SIZE; ++i)
+        values[i] = running += values[i];
+    }
+    return BLOCK_SIZE;
+  }
+
+  const_iterator begin() const {
+    return cbegin();
+  }
+
+  const_iterator end() const {
+    return cend();
+  }
+
+  const_iterator cbegin() const {
+    return const_iterator(0, this);
+  }
+
+  const_iterator cend() const {
+    return const_iterator(size, this);
+  }
+
+private:
+  using Unsigned = typename std::make_unsigned<Type>::type;
+  using Unpacker = detail::BlockUnpacker<Unsigned, BLOCK_SIZE>;
+
+  enum Encoding : std::uint8_t { FRAME, DELTA };
+
+  struct BlockInfo {
+    Unsigned base;    // minimum for FRAME, first value for DELTA
+    size_type offset; // first packed word
+    std::uint8_t bits;
+    std::uint8_t encoding;
+  };
+
+  size_type tailSize() const {
+    return size - blocks.getSize() * BLOCK_SIZE;
+  }
+
+  void copyTail(const CompressedIntVector& other) {
+    for(size_type i = 0; i < tailSize(); ++i)
+      tail[i] = other.tail[i];
+  }
+
+  // Packs the full tail into 2 * bits words, reusing the padding word as the
+  // first one and appending a fresh one after it.
+  void sealTail() {
+    Type low = tail[0], high = tail[0];
+    bool sorted = true;
+    Unsigned maxDelta = 0;
+    for(size_type i = 1; i < BLOCK_SIZE; ++i) {
+      if(tail[i] < low)
+        low = tail[i];
+      if(tail[i] > high)
+        high = tail[i];
+      if(tail[i] < tail[i - 1])
+        sorted = false;
+      Unsigned delta = static_cast<Unsigned>(tail[i]) - static_cast<Unsigned>(tail[i - 1]);
+      if(delta > maxDelta)
+        maxDelta = delta;
+    }
+    unsigned frameBits = detail::bitWidth(static_cast<Unsigned>(high) - static_cast<Unsigned>(low));
+    unsigned deltaBits = detail::bitWidth(maxDelta);
+
+    BlockInfo info;
+    info.offset = words.getSize() - 1;
+    if(sorted && deltaBits < frameBits) {
+      info.encoding = DELTA;
+      info.base = static_cast<Unsigned>(tail[0]);
+      info.bits = static_cast<std::uint8_t>(deltaBits);
+    }
+    else {
+      info.encoding = FRAME;
+      info.base = static_cast<Unsigned>(low);
+      info.bits = static_cast<std::uint8_t>(frameBits);
+    }
+
+    size_type blockWords = 2 * info.bits; // BLOCK_SIZE * bits / 64
+    words.reserve(words.getSize() + blockWords);
+    for(size_type i = 0; i < blockWords; ++i)
+      words.append(0);
+    std::uint64_t* packed = words.data() + info.offset;
+    for(size_type i = 0; i < BLOCK_SIZE; ++i) {
+      Unsigned previous = info.encoding == FRAME || i == 0 ? info.base : static_cast<Unsigned>(tail[i - 1]);
+      detail::packBits(packed, i, info.bits, static_cast<Unsigned>(static_cast<Unsigned>(tail[i]) - previous));
+    }
+    blocks.append(info);
+  }
+
+  void unsealLastBlock() {
+    ++unseals;
+    decodeBlock(blocks.getSize() - 1, tail);
+    BlockInfo info = blocks.popLast();
+    for(size_type i = 0; i < 2u * info.bits; ++i)
+      words.popLast();
+    words.data()[info.offset] = 0;
+  }
+
+  Vector<std::uint64_t> words;
+  Vector<BlockInfo> blocks;
+  Type tail[BLOCK_SIZE];
+  size_type size;
+  size_type unseals; // a block unsealed by popLast may be sealed again with other values
+};
+
+// Keeps the block under the cursor decoded, so a scan unpacks every block once.
+// The decoded copy makes every iterator BLOCK_SIZE values large (1 KiB for
+// 64-bit types). Values in the tail are read from the vector directly, and a
+// cached block is decoded again once popLast has unsealed a block.
+template <typename Type>
+class CompressedIntVector<Type>::ConstIterator
+{
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename CompressedIntVector::value_type;
+  using difference_type = typename CompressedIntVector::difference_type;
+  using pointer = void;
+  using reference = typename CompressedIntVector::const_reference;
+
+  explicit ConstIterator(size_type i = 0, const CompressedIntVector* v = nullptr)
+    : index(i), vec(v), cachedBlock(NO_BLOCK), cachedUnseals(0) {}
+
+  // The decoded block is not copied; the copy decodes again on first use.
+  ConstIterator(const ConstIterator& other)
+    : index(other.index), vec(other.vec), cachedBlock(NO_BLOCK), cachedUnseals(0) {}
+
+  ConstIterator& operator=(const ConstIterator& other) {
+    index = other.index;
+    vec = other.vec;
+    cachedBlock = NO_BLOCK;
+    return *this;
+  }
+
+  reference operator*() const {
+    if(index >= vec->size)
+      throw std::out_of_range("Attempt to dereference end iterator");
+    size_type block = index / BLOCK_SIZE;
+    if(block == vec->blocks.getSize())
+      return vec->tail[index % BLOCK_SIZE];
+    if(block != cachedBlock || cachedUnseals != vec->unseals) {
+      vec->decodeBlock(block, cache);
+      cachedBlock = block;
+      cachedUnseals = vec->unseals;
+    }
+    return cache[index % BLOCK_SIZE];
+  }
+
+  ConstIterator& operator++() {
+    if(index == vec->size)
+      throw std::out_of_range("Attempt to increment end iterator");
+    ++index;
+    return *this;
+  }
+
+  ConstIterator operator++(int) {
+    ConstIterator result = *this;
+    operator++();
+    return result;
+  }
+
+  ConstIterator& operator--() {
+    if(index == 0)
+      throw std::out_of_range("Attempt to decrement begin iterator");
+    --index;
+    return *this;
+  }
+
+  ConstIterator operator--(int) {
+    ConstIterator result = *this;
+    operator--();
+    return result;
+  }
+
+  ConstIterator operator+(difference_type d) const {
+    if(index + d > vec->size)
+      throw std::out_of_range("Attempt to add out of vector range");
+    return ConstIterator(index + d, vec);
+  }
+
+  ConstIterator operator-(difference_type d) const {
+    if(d > static_cast<difference_type>(index))
+      throw std::out_of_range("Attempt to substract out of vector range");
+    return ConstIterator(index - d, vec);
+  }
+
+  bool operator==(const ConstIterator& other) const {
+    return vec == other.vec && index == other.index;
+  }
+
+  bool operator!=(const ConstIterator& other) const {
+    return !operator==(other);
+  }
+
+private:
+  static const size_type NO_BLOCK = static_cast<size_type>(-1);
+
+  size_type index;
+  const CompressedIntVector* vec;
+  mutable size_type cachedBlock;
+  mutable size_type cachedUnseals;
+  mutable Type cache[BLOCK_SIZE];
+};
+
+}
+
+#endif // AISDI_LINEAR_COMPRESSEDINTVECTOR_H
@@ -0,0 +1,229 @@
+#ifndef AISDI_LINEAR_CONTAINERSTATS_H
+#define AISDI_LINEAR_CONTAINERSTATS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+// Stats policies for Vector and LinkedList. Containers derive privately from
+// the policy and call its hooks; NoStats is empty with empty hooks, so the
+// default instantiations are unchanged in size and code. CountingStats keeps
+// per-container counters and adds every event to StatsRegistry::global().
+// MemoryUsage is the footprint snapshot returned by memoryUsage().
+
+namespace aisdi
+{
+
+struct StatsCounters {
+  std::uint64_t allocations = 0;    // buffers, not counting list nodes
+  std::uint64_t frees = 0;
+  std::uint64_t reallocations = 0;  // growth and other buffer moves
+  std::uint64_t elementsCopied = 0; // during reallocation and shifting
+  std::uint64_t bytesCopied = 0;
+  std::uint64_t peakCapacity = 0;   // elements
+  std::uint64_t nodeAllocations = 0;
+  std::uint64_t nodeFrees = 0;
+  std::int64_t liveNodes = 0;
+  std::int64_t peakLiveNodes = 0;
+};
+
+struct MemoryUsage {
+  std::size_t usedBytes = 0;        // element payload
+  std::size_t slackBytes = 0;       // reserved but unused
+  std::size_t overheadBytes = 0;    // container object, node links and sentinels
+  std::size_t allocatorBytes = 0;   // estimated heap headers and rounding
+  std::size_t allocations = 0;      // live heap blocks
+  std::size_t perNodeOverhead = 0;  // link bytes per element, 0 for contiguous storage
+
+  std::size_t totalBytes() const {
+    return usedBytes + slackBytes + overheadBytes + allocatorBytes;
+  }
+};
+
+inline void writeJson(std::ostream& out, const StatsCounters& c) {
+  out << "{\"allocations\": " << c.allocations << ", \"frees\": " << c.frees
+      << ", \"reallocations\": " << c.reallocations << ", \"elements_copied\": " << c.elementsCopied
+      << ", \"bytes_copied\": " << c.bytesCopied << ", \"peak_capacity\": " << c.peakCapacity
+      << ", \"node_allocations\": " << c.nodeAllocations << ", \"node_frees\": " << c.nodeFrees
+      << ", \"live_nodes\": " << c.liveNodes << ", \"peak_live_nodes\": " << c.peakLiveNodes << '}';
+}
+
+// Process-wide sums over all containers using CountingStats. Peaks are the
+// largest single capacity and the largest number of nodes alive at once.
+class StatsRegistry
+{
+public:
+  static StatsRegistry& global() {
+    static StatsRegistry registry;
+    return registry;
+  }
+
+  void allocated(std::size_t capacity) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    raise(peakCapacity, capacity);
+  }
+
+  void freed() {
+    frees.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void reallocated() {
+    reallocations.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void copied(std::size_t elements, std::size_t bytes) {
+    elementsCopied.fetch_add(elements, std::memory_order_relaxed);
+    bytesCopied.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  void nodeAllocated() {
+    nodeAllocations.fetch_add(1, std::memory_order_relaxed);
+    std::int64_t live = liveNodes.fetch_add(1, std::memory_order_relaxed) + 1;
+    raise(peakLiveNodes, live);
+  }
+
+  void nodeFreed() {
+    nodeFrees.fetch_add(1, std::memory_order_relaxed);
+    liveNodes.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  void nodesFreed(std::size_t count) {
+    nodeFrees.fetch_add(count, std::memory_order_relaxed);
+    liveNodes.fetch_sub(static_cast<std::int64_t>(count), std::memory_order_relaxed);
+  }
+
+  StatsCounters snapshot() const {
+    StatsCounters c;
+    c.allocations = allocations.load(std::memory_order_relaxed);
+    c.frees = frees.load(std::memory_order_relaxed);
+    c.reallocations = reallocations.load(std::memory_order_relaxed);
+    c.elementsCopied = elementsCopied.load(std::memory_order_relaxed);
+    c.bytesCopied = bytesCopied.load(std::memory_order_relaxed);
+    c.peakCapacity = peakCapacity.load(std::memory_order_relaxed);
+    c.nodeAllocations = nodeAllocations.load(std::memory_order_relaxed);
+    c.nodeFrees = nodeFrees.load(std::memory_order_relaxed);
+    c.liveNodes = liveNodes.load(std::memory_order_relaxed);
+    c.peakLiveNodes = peakLiveNodes.load(std::memory_order_relaxed);
+    return c;
+  }
+
+  // Clears the event counts; live nodes stay, since those nodes still exist.
+  void reset() {
+    allocations.store(0, std::memory_order_relaxed);
+    frees.store(0, std::memory_order_relaxed);
+    reallocations.store(0, std::memory_order_relaxed);
+    elementsCopied.store(0, std::memory_order_relaxed);
+    bytesCopied.store(0, std::memory_order_relaxed);
+    peakCapacity.store(0, std::memory_order_relaxed);
+    nodeAllocations.store(0, std::memory_order_relaxed);
+    nodeFrees.store(0, std::memory_order_relaxed);
+    peakLiveNodes.store(liveNodes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+
+  void dumpJson(std::ostream& out) const {
+    writeJson(out, snapshot());
+  }
+
+private:
+  StatsRegistry() = default;
+
+  template <typename Counter, typename Value>
+  static void raise(std::atomic<Counter>& peak, Value value) {
+    Counter candidate = static_cast<Counter>(value);
+    Counter current = peak.load(std::memory_order_relaxed);
+    while(candidate > current && !peak.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+      ;
+  }
+
+  std::atomic<std::uint64_t> allocations{ 0 };
+  std::atomic<std::uint64_t> frees{ 0 };
+  std::atomic<std::uint64_t> reallocations{ 0 };
+  std::atomic<std::uint64_t> elementsCopied{ 0 };
+  std::atomic<std::uint64_t> bytesCopied{ 0 };
+  std::atomic<std::uint64_t> peakCapacity{ 0 };
+  std::atomic<std::uint64_t> nodeAllocations{ 0 };
+  std::atomic<std::uint64_t> nodeFrees{ 0 };
+  std::atomic<std::int64_t> liveNodes{ 0 };
+  std::atomic<std::int64_t> peakLiveNodes{ 0 };
+};
+
+struct NoStats {
+  void onAllocate(std::size_t) {}
+  void onFree() {}
+  void onReallocate() {}
+  void onCopy(std::size_t, std::size_t) {}
+  void onNodeAllocate() {}
+  void onNodeFree() {}
+  void onNodesFreed(std::size_t) {}
+  void onNodesMoved(std::ptrdiff_t) {}
+
+  StatsCounters counters() const {
+    return StatsCounters();
+  }
+};
+
+class CountingStats
+{
+public:
+  void onAllocate(std::size_t capacity) {
+    ++c.allocations;
+    if(capacity > c.peakCapacity)
+      c.peakCapacity = capacity;
+    StatsRegistry::global().allocated(capacity);
+  }
+
+  void onFree() {
+    ++c.frees;
+    StatsRegistry::global().freed();
+  }
+
+  void onReallocate() {
+    ++c.reallocations;
+    StatsRegistry::global().reallocated();
+  }
+
+  void onCopy(std::size_t elements, std::size_t bytes) {
+    c.elementsCopied += elements;
+    c.bytesCopied += bytes;
+    StatsRegistry::global().copied(elements, bytes);
+  }
+
+  void onNodeAllocate() {
+    ++c.nodeAllocations;
+    if(++c.liveNodes > c.peakLiveNodes)
+      c.peakLiveNodes = c.liveNodes;
+    StatsRegistry::global().nodeAllocated();
+  }
+
+  void onNodeFree() {
+    ++c.nodeFrees;
+    --c.liveNodes;
+    StatsRegistry::global().nodeFreed();
+  }
+
+  // A whole chain handed to a Reclaimer, counted as freed right away.
+  void onNodesFreed(std::size_t count) {
+    c.nodeFrees += count;
+    c.liveNodes -= static_cast<std::int64_t>(count);
+    StatsRegistry::global().nodesFreed(count);
+  }
+
+  // Nodes handed over by a move; the process-wide total does not change.
+  void onNodesMoved(std::ptrdiff_t delta) {
+    c.liveNodes += delta;
+    if(c.liveNodes > c.peakLiveNodes)
+      c.peakLiveNodes = c.liveNodes;
+  }
+
+  const StatsCounters& counters() const {
+    return c;
+  }
+
+private:
+  StatsCounters c;
+};
+
+}
+
+#endif // AISDI_LINEAR_CONTAINERSTATS_H
@@ -0,0 +1,223 @@
+#ifndef AISDI_LINEAR_COWVECTOR_H
+#define AISDI_LINEAR_COWVECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+
+#include "Vector.h"
+
+namespace aisdi
+{
+
+// Copy-on-write Vector: copies share one reference-counted Vector and the
+// first mutating call on a shared copy (append, insert, erase, non-const
+// begin/end, ...) detaches it. Once data() or a mutable iterator has been
+// handed out, the buffer is unshareable: later copies get their own Vector
+// right away, so writes through that iterator never reach them. Vector
+// iterators outlive reallocations, so a mutable iteration opts the object out
+// of sharing for good; range-for over view() reads without doing so. Copies
+// may live on different threads; as with Vector, a single CowVector object
+// must not be used by two threads at once.
+template <typename Type>
+class CowVector
+{
+  static_assert(!std::is_same<Type, bool>::value,
+                "CowVector hands out Vector iterators and Type*, which the packed Vector<bool> lacks");
+
+public:
+  using difference_type = typename Vector<Type>::difference_type;
+  using size_type = typename Vector<Type>::size_type;
+  using value_type = Type;
+  using pointer = Type*;
+  using reference = Type&;
+  using const_pointer = const Type*;
+  using const_reference = const Type&;
+
+  using iterator = typename Vector<Type>::iterator;
+  using const_iterator = typename Vector<Type>::const_iterator;
+
+  CowVector() : shared(new Shared()) {}
+
+  CowVector(std::initializer_list<Type> l) : shared(new Shared(l)) {}
+
+  CowVector(const CowVector& other) : shared(share(other.shared)) {}
+
+  CowVector(CowVector&& other) : shared(other.shared) {
+    other.shared = new Shared(); //reinitialize
+  }
+
+  ~CowVector() {
+    release(shared);
+  }
+
+  CowVector& operator=(const CowVector& other) {
+    if(shared == other.shared)
+      return *this;
+    Shared* toRelease = shared;
+    shared = share(other.shared);
+    release(toRelease);
+    return *this;
+  }
+
+  CowVector& operator=(CowVector&& other) {
+    if(this == &other)
+      return *this;
+    Shared* toRelease = shared;
+    shared = other.shared;
+    other.shared = new Shared();
+    release(toRelease);
+    return *this;
+  }
+
+  bool isShared() const {
+    return shared->refs.load(std::memory_order_acquire) != 1;
+  }
+
+  bool isEmpty() const {
+    return shared->vector.isEmpty();
+  }
+
+  size_type getSize() const {
+    return shared->vector.getSize();
+  }
+
+  const_pointer data() const {
+    return shared->vector.data();
+  }
+
+  pointer data() {
+    return leakedVector().data();
+  }
+
+  void append(const Type& item) {
+    mutableVector().append(item);
+  }
+
+  void prepend(const Type& item) {
+    mutableVector().prepend(item);
+  }
+
+  void insert(const const_iterator& insertPosition, const Type& item) {
+    Vector<Type>& vector = mutableVector();
+    vector.insert(rebind(insertPosition, vector), item);
+  }
+
+  Type popFirst() {
+    if(isEmpty())
+      throw std::logic_error("Attempt to pop first in empty vector");
+    return mutableVector().popFirst();
+  }
+
+  Type popLast() {
+    if(isEmpty())
+      throw std::logic_error("Attempt to pop last in empty vector");
+    return mutableVector().popLast();
+  }
+
+  void erase(const const_iterator& position) {
+    Vector<Type>& vector = mutableVector();
+    vector.erase(rebind(position, vector));
+  }
+
+  void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded) {
+    Vector<Type>& vector = mutableVector();
+    vector.erase(rebind(firstIncluded, vector), rebind(lastExcluded, vector));
+  }
+
+  const_iterator find(const Type& item) const {
+    return shared->vector.find(item);
+  }
+
+  bool contains(const Type& item) const {
+    return shared->vector.contains(item);
+  }
+
+  size_type count(const Type& item) const {
+    return shared->vector.count(item);
+  }
+
+  // Read-only access for range-for on a non-const object, which would
+  // otherwise pick the mutable begin/end and make the buffer unshareable.
+  const CowVector& view() const {
+    return *this;
+  }
+
+  // Iterators handed out by the non-const overloads may write, so they detach.
+  iterator begin() {
+    return leakedVector().begin();
+  }
+
+  iterator end() {
+    return leakedVector().end();
+  }
+
+  const_iterator cbegin() const {
+    return shared->vector.cbegin();
+  }
+
+  const_iterator cend() const {
+    return shared->vector.cend();
+  }
+
+  const_iterator begin() const {
+    return cbegin();
+  }
+
+  const_iterator end() const {
+    return cend();
+  }
+
+private:
+  struct Shared {
+    std::atomic<long> refs;
+    bool unshareable; // only set while refs is 1
+    Vector<Type> vector;
+
+    Shared() : refs(1), unshareable(false) {}
+    explicit Shared(std::initializer_list<Type> l) : refs(1), unshareable(false), vector(l) {}
+    explicit Shared(const Vector<Type>& v) : refs(1), unshareable(false), vector(v) {}
+  };
+
+  static Shared* share(Shared* s) {
+    if(s->unshareable)
+      return new Shared(s->vector);
+    s->refs.fetch_add(1, std::memory_order_relaxed);
+    return s;
+  }
+
+  static void release(Shared* s) {
+    if(s->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      delete s;
+  }
+
+  // The acquire load pairs with release() on other threads, so their reads of
+  // the old buffer are finished before this copy starts writing to it.
+  Vector<Type>& mutableVector() {
+    if(shared->refs.load(std::memory_order_acquire) != 1) {
+      Shared* copy = new Shared(shared->vector);
+      release(shared);
+      shared = copy;
+    }
+    return shared->vector;
+  }
+
+  // For callers that keep a way to write into the buffer after returning.
+  Vector<Type>& leakedVector() {
+    Vector<Type>& vector = mutableVector();
+    shared->unshareable = true;
+    return vector;
+  }
+
+  // Positions obtained before a detach still point into the shared buffer.
+  static const_iterator rebind(const const_iterator& position, const Vector<Type>& vector) {
+    return const_iterator(position.index, &vector);
+  }
+
+  Shared* shared;
+};
+
+}
+
+#endif // AISDI_LINEAR_COWVECTOR_H
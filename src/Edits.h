@@ -0,0 +1,72 @@
+#ifndef AISDI_LINEAR_EDITS_H
+#define AISDI_LINEAR_EDITS_H
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace aisdi
+{
+
+enum class EditOp {
+  Insert,  // before the element at position
+  Erase,
+  Replace
+};
+
+// One operation of a batch for applyEdits. Positions index the sequence as
+// it was before the batch, so a batch is built without adjusting positions
+// for the edits before it.
+template <typename Type>
+struct Edit {
+  EditOp op;
+  std::size_t position;
+  Type value; // unused for Erase
+
+  static Edit insert(std::size_t position, const Type& value) {
+    return Edit{ EditOp::Insert, position, value };
+  }
+
+  static Edit erase(std::size_t position) {
+    return Edit{ EditOp::Erase, position, Type() };
+  }
+
+  static Edit replace(std::size_t position, const Type& value) {
+    return Edit{ EditOp::Replace, position, value };
+  }
+};
+
+namespace detail
+{
+
+struct EditCounts {
+  std::size_t inserts;
+  std::size_t erases;
+};
+
+// A batch must be sorted by position. At one position, inserts come first,
+// in the order they should appear, followed by at most one Erase or
+// Replace. Checked up front so a rejected batch leaves the container as is.
+template <typename Edits>
+EditCounts checkEdits(const Edits& edits, std::size_t size) {
+  EditCounts counts = { 0, 0 };
+  std::size_t position = 0;
+  bool positionTaken = false; // an Erase or Replace was seen at position
+  for(const auto& edit : edits) {
+    if(edit.position < position || (edit.position == position && positionTaken))
+      throw std::invalid_argument("Edits must be sorted, inserts first at each position");
+    if(edit.position > size || (edit.op != EditOp::Insert && edit.position == size))
+      throw std::out_of_range("Edit position out of range");
+    positionTaken = edit.op != EditOp::Insert;
+    position = edit.position;
+    if(edit.op == EditOp::Insert)
+      ++counts.inserts;
+    else if(edit.op == EditOp::Erase)
+      ++counts.erases;
+  }
+  return counts;
+}
+
+}
+}
+
+#endif // AISDI_LINEAR_EDITS_H
@@ -0,0 +1,301 @@
+#ifndef AISDI_LINEAR_FLATMAP_H
+#define AISDI_LINEAR_FLATMAP_H
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "FlatSet.h"
+#include "Vector.h"
+
+namespace aisdi
+{
+
+// Sorted map with keys and values in two parallel Vectors, so a lookup only
+// touches the densely packed keys until it lands on the right index. Values
+// live in an UnpackedVector, so bool values can be returned by reference.
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class FlatMap
+{
+  static_assert(!std::is_same<Key, bool>::value, "bool keys are not supported: the packed Vector<bool> has no key buffer");
+
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using key_type = Key;
+  using mapped_type = Value;
+  using key_compare = Compare;
+
+  class ConstIterator;
+  class Iterator;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  explicit FlatMap(const Compare& c = Compare()) : comp(c) {}
+
+  FlatMap(std::initializer_list<std::pair<Key, Value>> l, const Compare& c = Compare()) : comp(c) {
+    for(auto it = l.begin(); it != l.end(); ++it)
+      insert(it->first, it->second);
+  }
+
+  bool isEmpty() const {
+    return keyVector.isEmpty();
+  }
+
+  size_type getSize() const {
+    return keyVector.getSize();
+  }
+
+  bool insert(const Key& key, const Value& value) {
+    size_type index = lowerBoundIndex(key);
+    if(index != getSize() && !comp(key, keyVector.data()[index]))
+      return false;
+    keyVector.insert(keyVector.cbegin() + index, key);
+    valueVector.insert(valueVector.cbegin() + index, value);
+    return true;
+  }
+
+  // Merges an ascending range of (key, value) pairs in a single pass with one
+  // allocation per column; existing keys keep their values.
+  template <typename ForwardIt>
+  void insertSorted(ForwardIt first, ForwardIt last) {
+    size_type incoming = std::distance(first, last);
+    Vector<Key> mergedKeys;
+    UnpackedVector<Value> mergedValues;
+    mergedKeys.reserve(getSize() + incoming);
+    mergedValues.reserve(getSize() + incoming);
+    size_type mine = 0;
+    while(mine != getSize() || first != last) {
+      const Key* key;
+      const Value* value;
+      if(first == last || (mine != getSize() && !comp(first->first, keyVector.data()[mine]))) {
+        key = keyVector.data() + mine;
+        value = &detail::unpacked(valueVector.data()[mine]);
+        ++mine;
+      }
+      else {
+        key = &first->first;
+        value = &first->second;
+        ++first;
+      }
+      if(mergedKeys.isEmpty() || comp(mergedKeys.data()[mergedKeys.getSize() - 1], *key)) {
+        mergedKeys.append(*key);
+        mergedValues.append(*value);
+      }
+    }
+    keyVector = std::move(mergedKeys);
+    valueVector = std::move(mergedValues);
+  }
+
+  template <typename Range>
+  void insertSorted(const Range& range) {
+    insertSorted(std::begin(range), std::end(range));
+  }
+
+  void insertSorted(std::initializer_list<std::pair<Key, Value>> l) {
+    insertSorted(l.begin(), l.end());
+  }
+
+  bool erase(const Key& key) {
+    size_type index = findIndex(key);
+    if(index == getSize())
+      return false;
+    keyVector.erase(keyVector.cbegin() + index);
+    valueVector.erase(valueVector.cbegin() + index);
+    return true;
+  }
+
+  Value& operator[](const Key& key) {
+    size_type index = lowerBoundIndex(key);
+    if(index == getSize() || comp(key, keyVector.data()[index])) {
+      keyVector.insert(keyVector.cbegin() + index, key);
+      valueVector.insert(valueVector.cbegin() + index, Value());
+    }
+    return detail::unpacked(valueVector.data()[index]);
+  }
+
+  const Value& at(const Key& key) const {
+    size_type index = findIndex(key);
+    if(index == getSize())
+      throw std::out_of_range("Attempt to access missing key");
+    return detail::unpacked(valueVector.data()[index]);
+  }
+
+  Value& at(const Key& key) {
+    return const_cast<Value&>(static_cast<const FlatMap&>(*this).at(key));
+  }
+
+  const_iterator lowerBound(const Key& key) const {
+    return const_iterator(lowerBoundIndex(key), this);
+  }
+
+  iterator lowerBound(const Key& key) {
+    return iterator(lowerBoundIndex(key), this);
+  }
+
+  const_iterator find(const Key& key) const {
+    return const_iterator(findIndex(key), this);
+  }
+
+  iterator find(const Key& key) {
+    return iterator(findIndex(key), this);
+  }
+
+  bool contains(const Key& key) const {
+    return findIndex(key) != getSize();
+  }
+
+  const Vector<Key>& keys() const {
+    return keyVector;
+  }
+
+  const UnpackedVector<Value>& values() const {
+    return valueVector;
+  }
+
+  iterator begin() {
+    return iterator(0, this);
+  }
+
+  iterator end() {
+    return iterator(getSize(), this);
+  }
+
+  const_iterator cbegin() const {
+    return const_iterator(0, this);
+  }
+
+  const_iterator cend() const {
+    return const_iterator(getSize(), this);
+  }
+
+  const_iterator begin() const {
+    return cbegin();
+  }
+
+  const_iterator end() const {
+    return cend();
+  }
+
+private:
+  size_type lowerBoundIndex(const Key& key) const {
+    return detail::lowerBoundIndex(keyVector.data(), keyVector.getSize(), key, comp);
+  }
+
+  size_type findIndex(const Key& key) const { // getSize() if not found
+    size_type index = lowerBoundIndex(key);
+    if(index != getSize() && comp(key, keyVector.data()[index]))
+      return getSize();
+    return index;
+  }
+
+  Vector<Key> keyVector;
+  UnpackedVector<Value> valueVector;
+  Compare comp;
+};
+
+template <typename Key, typename Value, typename Compare>
+class FlatMap<Key, Value, Compare>::ConstIterator
+{
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = std::pair<const Key, Value>;
+  using difference_type = typename FlatMap::difference_type;
+
+  explicit ConstIterator(size_type i = 0, const FlatMap* m = nullptr) : index(i), map(m) {}
+
+  const Key& key() const {
+    checkDereferenceable();
+    return map->keyVector.data()[index];
+  }
+
+  const Value& value() const {
+    checkDereferenceable();
+    return detail::unpacked(map->valueVector.data()[index]);
+  }
+
+  ConstIterator& operator++() {
+    if(index == map->getSize())
+      throw std::out_of_range("Attempt to increment end iterator");
+    ++index;
+    return *this;
+  }
+
+  ConstIterator operator++(int) {
+    ConstIterator result = *this;
+    operator++();
+    return result;
+  }
+
+  ConstIterator& operator--() {
+    if(index == 0)
+      throw std::out_of_range("Attempt to decrement begin iterator");
+    --index;
+    return *this;
+  }
+
+  ConstIterator operator--(int) {
+    ConstIterator result = *this;
+    operator--();
+    return result;
+  }
+
+  bool operator==(const ConstIterator& other) const {
+    return map == other.map && index == other.index;
+  }
+
+  bool operator!=(const ConstIterator& other) const {
+    return !operator==(other);
+  }
+
+protected:
+  void checkDereferenceable() const {
+    if(index >= map->getSize())
+      throw std::out_of_range("Attempt to dereference end iterator");
+  }
+
+  size_type index;
+  const FlatMap* map;
+};
+
+template <typename Key, typename Value, typename Compare>
+class FlatMap<Key, Value, Compare>::Iterator : public FlatMap<Key, Value, Compare>::ConstIterator
+{
+public:
+  explicit Iterator(size_type i, const FlatMap* m) : ConstIterator(i, m) {}
+
+  Iterator& operator++() {
+    ConstIterator::operator++();
+    return *this;
+  }
+
+  Iterator operator++(int) {
+    auto result = *this;
+    ConstIterator::operator++();
+    return result;
+  }
+
+  Iterator& operator--() {
+    ConstIterator::operator--();
+    return *this;
+  }
+
+  Iterator operator--(int) {
+    auto result = *this;
+    ConstIterator::operator--();
+    return result;
+  }
+
+  Value& value() const {
+    // keys stay const, values may be changed in place
+    return const_cast<Value&>(ConstIterator::value());
+  }
+};
+
+}
+
+#endif // AISDI_LINEAR_FLATMAP_H
@@ -0,0 +1,159 @@
+#ifndef AISDI_LINEAR_FLATSET_H
+#define AISDI_LINEAR_FLATSET_H
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "Vector.h"
+
+namespace aisdi
+{
+namespace detail
+{
+
+// Branchless lower bound: the loop length only depends on count, the compare
+// result selects the next base with a conditional move, and both possible
+// next probes are prefetched.
+template <typename Key, typename Compare>
+std::size_t lowerBoundIndex(const Key* data, std::size_t count, const Key& key, Compare comp) {
+  if(count == 0)
+    return 0;
+  const Key* base = data;
+  std::size_t n = count;
+  while(n > 1) {
+    std::size_t half = n / 2;
+    __builtin_prefetch(base + half / 2);
+    __builtin_prefetch(base + half + half / 2);
+    base = comp(base[half], key) ? base + half : base;
+    n -= half;
+  }
+  return (base - data) + comp(*base, key);
+}
+
+}
+
+// Sorted set of unique keys kept in one contiguous Vector.
+template <typename Key, typename Compare = std::less<Key>>
+class FlatSet
+{
+  static_assert(!std::is_same<Key, bool>::value, "bool keys are not supported: the packed Vector<bool> has no key buffer");
+
+public:
+  using size_type = std::size_t;
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using const_iterator = typename Vector<Key>::const_iterator;
+  using iterator = const_iterator; // keys must not be changed in place
+
+  explicit FlatSet(const Compare& c = Compare()) : comp(c) {}
+
+  FlatSet(std::initializer_list<Key> l, const Compare& c = Compare()) : comp(c) {
+    for(auto it = l.begin(); it != l.end(); ++it)
+      insert(*it);
+  }
+
+  bool isEmpty() const {
+    return keys.isEmpty();
+  }
+
+  size_type getSize() const {
+    return keys.getSize();
+  }
+
+  bool insert(const Key& key) {
+    size_type index = lowerBoundIndex(key);
+    if(index != getSize() && !comp(key, keys.data()[index]))
+      return false;
+    keys.insert(keys.cbegin() + index, key);
+    return true;
+  }
+
+  // Merges an ascending range in a single pass with one allocation;
+  // duplicates (also within the range) are dropped.
+  template <typename ForwardIt>
+  void insertSorted(ForwardIt first, ForwardIt last) {
+    Vector<Key> merged;
+    merged.reserve(getSize() + std::distance(first, last));
+    const Key* mine = keys.data();
+    const Key* mineEnd = mine + getSize();
+    while(mine != mineEnd || first != last) {
+      const Key* next;
+      if(first == last || (mine != mineEnd && !comp(*first, *mine)))
+        next = mine++;
+      else
+        next = &*first++;
+      if(merged.isEmpty() || comp(merged.data()[merged.getSize() - 1], *next))
+        merged.append(*next);
+    }
+    keys = std::move(merged);
+  }
+
+  template <typename Range>
+  void insertSorted(const Range& range) {
+    insertSorted(std::begin(range), std::end(range));
+  }
+
+  void insertSorted(std::initializer_list<Key> l) {
+    insertSorted(l.begin(), l.end());
+  }
+
+  bool erase(const Key& key) {
+    const_iterator it = find(key);
+    if(it == cend())
+      return false;
+    keys.erase(it);
+    return true;
+  }
+
+  const_iterator lowerBound(const Key& key) const {
+    return keys.cbegin() + lowerBoundIndex(key);
+  }
+
+  const_iterator find(const Key& key) const {
+    size_type index = lowerBoundIndex(key);
+    if(index == getSize() || comp(key, keys.data()[index]))
+      return cend();
+    return keys.cbegin() + index;
+  }
+
+  bool contains(const Key& key) const {
+    return find(key) != cend();
+  }
+
+  const Vector<Key>& values() const {
+    return keys;
+  }
+
+  const_iterator cbegin() const {
+    return keys.cbegin();
+  }
+
+  const_iterator cend() const {
+    return keys.cend();
+  }
+
+  const_iterator begin() const {
+    return cbegin();
+  }
+
+  const_iterator end() const {
+    return cend();
+  }
+
+private:
+  size_type lowerBoundIndex(const Key& key) const {
+    return detail::lowerBoundIndex(keys.data(), keys.getSize(), key, comp);
+  }
+
+  Vector<Key> keys;
+  Compare comp;
+};
+
+}
+
+#endif // AISDI_LINEAR_FLATSET_H
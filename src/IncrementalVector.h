@@ -0,0 +1,419 @@
+#ifndef AISDI_LINEAR_INCREMENTALVECTOR_H
+#define AISDI_LINEAR_INCREMENTALVECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "Allocation.h"
+
+namespace aisdi
+{
+
+// Vector that never copies its whole buffer inside one append. When full it
+// allocates a buffer twice as large and moves at most migrationStep elements
+// per later operation, like incremental rehashing; until then indices in
+// [migrated, oldSize) are read from the old buffer. Every operation advances
+// the migration, so it finishes before the new buffer fills up. Operations
+// that shift elements (prepend, insert, popFirst, erase) are O(n) anyway and
+// finish the migration first. Allocation itself stays O(1) only for types
+// with trivial default construction. Old elements are destroyed as they
+// migrate, so the operation that finishes the migration only frees memory.
+template <typename Type>
+class IncrementalVector
+{
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = Type;
+  using pointer = Type*;
+  using reference = Type&;
+  using const_pointer = const Type*;
+  using const_reference = const Type&;
+
+  class ConstIterator;
+  class Iterator;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  static const size_type START_CAPACITY = 16;
+  static const size_type DEFAULT_MIGRATION_STEP = 32;
+
+  explicit IncrementalVector(size_type migrationStep = DEFAULT_MIGRATION_STEP)
+    : buffer(allocate(START_CAPACITY)), capacity(START_CAPACITY), size(0),
+      old(nullptr), oldCapacity(0), oldSize(0), migrated(0),
+      step(migrationStep ? migrationStep : 1) {}
+
+  IncrementalVector(std::initializer_list<Type> l) : IncrementalVector() {
+    for(auto it = l.begin(); it != l.end(); ++it)
+      append(*it);
+  }
+
+  IncrementalVector(const IncrementalVector& other)
+    : buffer(allocate(other.capacity)), capacity(other.capacity), size(other.size),
+      old(nullptr), oldCapacity(0), oldSize(0), migrated(0), step(other.step) {
+    for(size_type i = 0; i < size; ++i)
+      buffer[i] = other.element(i);
+  }
+
+  IncrementalVector(IncrementalVector&& other) : IncrementalVector(other.step) {
+    swap(other);
+  }
+
+  ~IncrementalVector() {
+    release(buffer, capacity);
+    if(old)
+      releaseOld();
+  }
+
+  IncrementalVector& operator=(const IncrementalVector& other) {
+    if(this != &other) {
+      IncrementalVector copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  IncrementalVector& operator=(IncrementalVector&& other) {
+    if(this != &other) {
+      IncrementalVector emptied(step);
+      swap(other);
+      other.swap(emptied);
+    }
+    return *this;
+  }
+
+  bool isEmpty() const {
+    return !size;
+  }
+
+  size_type getSize() const {
+    return size;
+  }
+
+  size_type getCapacity() const {
+    return capacity;
+  }
+
+  size_type getMigrationStep() const {
+    return step;
+  }
+
+  bool isMigrating() const {
+    return old != nullptr;
+  }
+
+  size_type pendingMigration() const { // elements still read from the old buffer
+    return old ? oldSize - migrated : 0;
+  }
+
+  // Moves everything left in the old buffer, e.g. while the caller is idle.
+  void finishMigration() {
+    if(old)
+      migrate(oldSize - migrated);
+  }
+
+  const_reference at(size_type index) const {
+    if(index >= size)
+      throw std::out_of_range("Index out of vector range");
+    return element(index);
+  }
+
+  reference at(size_type index) {
+    if(index >= size)
+      throw std::out_of_range("Index out of vector range");
+    return element(index);
+  }
+
+  void append(const Type& item) {
+    if(old)
+      migrate(step);
+    if(size == capacity) {
+      Type copy = item; // item may live in the buffer about to be retired
+      grow();
+      buffer[size++] = copy;
+      return;
+    }
+    buffer[size++] = item;
+  }
+
+  Type popLast() {
+    if(isEmpty())
+      throw std::logic_error("Attempt to pop last in empty vector");
+    Type last = element(--size);
+    if(old) {
+      if(oldSize > size) {
+        size_type kept = size > migrated ? size : migrated;
+        detail::destroyElements(old + kept, oldSize - kept);
+        oldSize = kept;
+      }
+      migrate(step);
+    }
+    return last;
+  }
+
+  void prepend(const Type& item) {
+    insertAt(0, item);
+  }
+
+  void insert(const const_iterator& insertPosition, const Type& item) {
+    insertAt(insertPosition.index, item);
+  }
+
+  Type popFirst() {
+    if(isEmpty())
+      throw std::logic_error("Attempt to pop first in empty vector");
+    Type first = element(0);
+    eraseRange(0, 1);
+    return first;
+  }
+
+  void erase(const const_iterator& position) {
+    if(isEmpty())
+      throw std::out_of_range("attempt to erase empty vector");
+    if(position.index >= size)
+      throw std::out_of_range("attempt to erase at end iterator");
+    eraseRange(position.index, position.index + 1);
+  }
+
+  void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded) {
+    if(isEmpty())
+      throw std::out_of_range("attempt to erase empty vector");
+    eraseRange(firstIncluded.index, lastExcluded.index);
+  }
+
+  iterator begin() {
+    return iterator(0, this);
+  }
+
+  iterator end() {
+    return iterator(size, this);
+  }
+
+  const_iterator cbegin() const {
+    return const_iterator(0, this);
+  }
+
+  const_iterator cend() const {
+    return const_iterator(size, this);
+  }
+
+  const_iterator begin() const {
+    return cbegin();
+  }
+
+  const_iterator end() const {
+    return cend();
+  }
+
+private:
+  static Type* allocate(size_type elements) {
+    return detail::allocateElements<Type>(elements, alignof(Type), false);
+  }
+
+  static void release(Type* elements, size_type count) {
+    detail::releaseElements(elements, count, false);
+  }
+
+  // Only the old slots in [migrated, oldSize) still hold objects; the rest
+  // were destroyed as they migrated or were popped.
+  void releaseOld() {
+    detail::destroyElements(old + migrated, oldSize - migrated);
+    detail::releaseBuffer(old, oldCapacity * sizeof(Type), false);
+  }
+
+  Type& element(size_type index) const {
+    return old && index >= migrated && index < oldSize ? old[index] : buffer[index];
+  }
+
+  void grow() {
+    finishMigration(); // not reached while every operation advances the migration
+    Type* bigger = allocate(2 * capacity);
+    old = buffer;
+    oldCapacity = capacity;
+    oldSize = size;
+    migrated = 0;
+    buffer = bigger;
+    capacity *= 2;
+  }
+
+  void migrate(size_type count) {
+    for(; count && migrated < oldSize; --count, ++migrated) {
+      buffer[migrated] = std::move(old[migrated]);
+      old[migrated].~Type();
+    }
+    if(migrated == oldSize) {
+      releaseOld();
+      old = nullptr;
+      oldCapacity = oldSize = migrated = 0;
+    }
+  }
+
+  void insertAt(size_type index, const Type& item) {
+    if(index > size)
+      throw std::out_of_range("Attempt to insert out of vector range");
+    Type copy = item; // item may live in this vector
+    finishMigration();
+    if(size == capacity) {
+      grow();
+      finishMigration();
+    }
+    for(size_type i = size; i > index; --i)
+      buffer[i] = buffer[i - 1];
+    buffer[index] = copy;
+    ++size;
+  }
+
+  void eraseRange(size_type first, size_type last) {
+    if(first > last || last > size)
+      throw std::out_of_range("Attempt to erase out of vector range");
+    finishMigration();
+    for(size_type i = last; i < size; ++i)
+      buffer[first + i - last] = buffer[i];
+    size -= last - first;
+  }
+
+  void swap(IncrementalVector& other) {
+    std::swap(buffer, other.buffer);
+    std::swap(capacity, other.capacity);
+    std::swap(size, other.size);
+    std::swap(old, other.old);
+    std::swap(oldCapacity, other.oldCapacity);
+    std::swap(oldSize, other.oldSize);
+    std::swap(migrated, other.migrated);
+    std::swap(step, other.step);
+  }
+
+  Type* buffer;
+  size_type capacity;
+  size_type size;
+  Type* old; // retired buffer, null when no migration is pending
+  size_type oldCapacity;
+  size_type oldSize;
+  size_type migrated;
+  size_type step;
+};
+
+template <typename Type>
+class IncrementalVector<Type>::ConstIterator
+{
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename IncrementalVector::value_type;
+  using difference_type = typename IncrementalVector::difference_type;
+  using pointer = typename IncrementalVector::const_pointer;
+  using reference = typename IncrementalVector::const_reference;
+
+  explicit ConstIterator(size_type i = 0, const IncrementalVector* v = nullptr) : index(i), vec(v) {}
+
+  reference operator*() const {
+    if(index >= vec->size)
+      throw std::out_of_range("Attempt to dereference end iterator");
+    return vec->element(index);
+  }
+
+  ConstIterator& operator++() {
+    if(index == vec->size)
+      throw std::out_of_range("Attempt to increment end iterator");
+    ++index;
+    return *this;
+  }
+
+  ConstIterator operator++(int) {
+    ConstIterator result = *this;
+    operator++();
+    return result;
+  }
+
+  ConstIterator& operator--() {
+    if(index == 0)
+      throw std::out_of_range("Attempt to decrement begin iterator");
+    --index;
+    return *this;
+  }
+
+  ConstIterator operator--(int) {
+    ConstIterator result = *this;
+    operator--();
+    return result;
+  }
+
+  ConstIterator operator+(difference_type d) const {
+    if(index + d > vec->size)
+      throw std::out_of_range("Attempt to add out of vector range");
+    return ConstIterator(index + d, vec);
+  }
+
+  ConstIterator operator-(difference_type d) const {
+    if(d > static_cast<difference_type>(index))
+      throw std::out_of_range("Attempt to substract out of vector range");
+    return ConstIterator(index - d, vec);
+  }
+
+  bool operator==(const ConstIterator& other) const {
+    return vec == other.vec && index == other.index;
+  }
+
+  bool operator!=(const ConstIterator& other) const {
+    return !operator==(other);
+  }
+
+protected:
+  size_type index;
+  const IncrementalVector* vec;
+
+  friend class IncrementalVector;
+};
+
+template <typename Type>
+class IncrementalVector<Type>::Iterator : public IncrementalVector<Type>::ConstIterator
+{
+public:
+  using pointer = typename IncrementalVector::pointer;
+  using reference = typename IncrementalVector::reference;
+
+  explicit Iterator(size_type i, const IncrementalVector* v) : ConstIterator(i, v) {}
+
+  Iterator(const ConstIterator& other)
+    : ConstIterator(other) {}
+
+  Iterator& operator++() {
+    ConstIterator::operator++();
+    return *this;
+  }
+
+  Iterator operator++(int) {
+    auto result = *this;
+    ConstIterator::operator++();
+    return result;
+  }
+
+  Iterator& operator--() {
+    ConstIterator::operator--();
+    return *this;
+  }
+
+  Iterator operator--(int) {
+    auto result = *this;
+    ConstIterator::operator--();
+    return result;
+  }
+
+  Iterator operator+(difference_type d) const {
+    return ConstIterator::operator+(d);
+  }
+
+  Iterator operator-(difference_type d) const {
+    return ConstIterator::operator-(d);
+  }
+
+  reference operator*() const {
+    // ugly cast, yet reduces code duplication.
+    return const_cast<reference>(ConstIterator::operator*());
+  }
+};
+
+}
+
+#endif // AISDI_LINEAR_INCREMENTALVECTOR_H
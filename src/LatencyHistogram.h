@@ -0,0 +1,133 @@
+#ifndef AISDI_LINEAR_LATENCYHISTOGRAM_H
+#define AISDI_LINEAR_LATENCYHISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace aisdi
+{
+
+// HDR-style histogram of non-negative integer values (nanoseconds in the
+// benchmark). Values below SUB_BUCKETS are counted exactly; above that every
+// power of two is split into SUB_BUCKETS / 2 linear buckets, so any recorded
+// value is known to within 1 / (SUB_BUCKETS / 2) of itself, whatever its
+// magnitude. Recording is O(1) and the bucket array has a fixed size.
+class LatencyHistogram
+{
+public:
+  static const int SUB_BUCKET_BITS = 7;
+  static const std::size_t SUB_BUCKETS = std::size_t(1) << SUB_BUCKET_BITS;
+  static const std::size_t HALF_BUCKETS = SUB_BUCKETS / 2;
+  static const std::size_t BUCKET_COUNT = SUB_BUCKETS + (64 - SUB_BUCKET_BITS) * HALF_BUCKETS;
+
+  LatencyHistogram() : counts(BUCKET_COUNT, 0), total(0), minimum(UINT64_MAX), maximum(0), sum(0) {}
+
+  void record(std::uint64_t value, std::uint64_t times = 1) {
+    if(!times)
+      return;
+    counts[bucketOf(value)] += times;
+    total += times;
+    sum += static_cast<double>(value) * times;
+    if(value < minimum)
+      minimum = value;
+    if(value > maximum)
+      maximum = value;
+  }
+
+  void merge(const LatencyHistogram& other) {
+    for(std::size_t i = 0; i < BUCKET_COUNT; ++i)
+      counts[i] += other.counts[i];
+    total += other.total;
+    sum += other.sum;
+    if(other.minimum < minimum)
+      minimum = other.minimum;
+    if(other.maximum > maximum)
+      maximum = other.maximum;
+  }
+
+  void reset() {
+    counts.assign(BUCKET_COUNT, 0);
+    total = 0;
+    minimum = UINT64_MAX;
+    maximum = 0;
+    sum = 0;
+  }
+
+  std::uint64_t count() const {
+    return total;
+  }
+
+  std::uint64_t min() const { // 0 when empty
+    return total ? minimum : 0;
+  }
+
+  std::uint64_t max() const {
+    return maximum;
+  }
+
+  double mean() const {
+    return total ? sum / total : 0;
+  }
+
+  // Highest value equivalent to the one at the given percentile (0..100),
+  // never more than the largest value recorded; 0 when empty.
+  std::uint64_t valueAtPercentile(double percentile) const {
+    if(!total)
+      return 0;
+    if(percentile > 100)
+      percentile = 100;
+    std::uint64_t rank = static_cast<std::uint64_t>(percentile / 100 * total + 0.5);
+    if(rank < 1)
+      rank = 1;
+    std::uint64_t seen = 0;
+    for(std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+      seen += counts[i];
+      if(seen >= rank)
+        return highestEquivalent(i) < maximum ? highestEquivalent(i) : maximum;
+    }
+    return maximum;
+  }
+
+  std::uint64_t countAt(std::size_t bucket) const {
+    return counts[bucket];
+  }
+
+  static std::size_t bucketOf(std::uint64_t value) {
+    if(value < SUB_BUCKETS)
+      return static_cast<std::size_t>(value);
+    int shift = highestBit(value) - SUB_BUCKET_BITS + 1;
+    std::size_t sub = static_cast<std::size_t>(value >> shift); // in [HALF_BUCKETS, SUB_BUCKETS)
+    return SUB_BUCKETS + (shift - 1) * HALF_BUCKETS + (sub - HALF_BUCKETS);
+  }
+
+  static std::uint64_t lowestEquivalent(std::size_t bucket) {
+    if(bucket < SUB_BUCKETS)
+      return bucket;
+    std::size_t shift = (bucket - SUB_BUCKETS) / HALF_BUCKETS + 1;
+    std::uint64_t sub = (bucket - SUB_BUCKETS) % HALF_BUCKETS + HALF_BUCKETS;
+    return sub << shift;
+  }
+
+  static std::uint64_t highestEquivalent(std::size_t bucket) {
+    if(bucket < SUB_BUCKETS)
+      return bucket;
+    std::size_t shift = (bucket - SUB_BUCKETS) / HALF_BUCKETS + 1;
+    return lowestEquivalent(bucket) + ((std::uint64_t(1) << shift) - 1);
+  }
+
+private:
+  static int highestBit(std::uint64_t value) {
+    return 63 - __builtin_clzll(value);
+  }
+
+  std::vector<std::uint64_t> counts;
+  std::uint64_t total;
+  std::uint64_t minimum;
+  std::uint64_t maximum;
+  double sum;
+};
+
+}
+
+#endif // AISDI_LINEAR_LATENCYHISTOGRAM_H
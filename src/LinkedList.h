@@ -5,11 +5,18 @@
 #include <initializer_list>
 #include <stdexcept>
 
+#include "Allocation.h"
+#include "ContainerStats.h"
+#include "Edits.h"
+#include "Reclaimer.h"
+
 namespace aisdi
 {
 
-template <typename Type>
-class LinkedList {
+// Stats = CountingStats records node allocations and live nodes, see stats().
+// destroyAsync() leaves freeing the nodes to a Reclaimer thread.
+template <typename Type, typename Stats = NoStats>
+class LinkedList : private Stats {
 
 public:
   using difference_type = std::ptrdiff_t;
@@ -53,6 +60,8 @@ public:
     head = other.head;
     tail = other.tail;
     size = other.size;
+    Stats::onNodesMoved(static_cast<std::ptrdiff_t>(size));
+    other.onNodesMoved(-static_cast<std::ptrdiff_t>(size));
 
 //reinitialize other
     other.head = tmp1;
@@ -61,21 +70,27 @@ public:
   }
 
   ~LinkedList() {
-    Node* tmp = head;
+    Node* tmp = head->next;
     while(tmp != tail) {
       tmp = tmp->next;
-      delete tmp->previous;
+      destroyNode(tmp->previous);
     }
+    delete head;
     delete tail;
   }
 
+  // Overwrites the existing nodes in place; allocates nodes only for the
+  // elements other has in excess and frees only the leftover tail.
   LinkedList& operator=(const LinkedList& other) {
     if(this == &other)
       return *this;
-    if(!isEmpty())
-      erase(cbegin(), cend());
+    Node* node = head->next;
+    const_iterator it = other.cbegin();
+    for(; node != tail && it != other.cend(); ++it, node = node->next)
+      static_cast<DataNode*>(node)->data = *it;
 
-    for(const_iterator it = other.cbegin(); it!= other.cend(); ++it)
+    erase(const_iterator(node), cend());
+    for(; it != other.cend(); ++it)
       append(*it);
     return *this;
   }
@@ -92,6 +107,8 @@ public:
     head = other.head;
     tail = other.tail;
     size = other.size;
+    Stats::onNodesMoved(static_cast<std::ptrdiff_t>(size));
+    other.onNodesMoved(-static_cast<std::ptrdiff_t>(size));
 
     other.head = tmp1;
     other.tail = tmp2;
@@ -108,20 +125,37 @@ public:
     return size;
   }
 
+  const Stats& stats() const {
+    return *this;
+  }
+
+  // Estimated footprint: every element is a DataNode, plus the two heap
+  // sentinels; allocator bytes assume glibc-style chunk headers.
+  MemoryUsage memoryUsage() const {
+    MemoryUsage usage;
+    usage.usedBytes = size * sizeof(Type);
+    usage.perNodeOverhead = sizeof(DataNode) - sizeof(Type);
+    usage.overheadBytes = sizeof(*this) + 2 * sizeof(Node) + size * usage.perNodeOverhead;
+    usage.allocatorBytes = size * detail::allocationOverhead(sizeof(DataNode))
+                         + 2 * detail::allocationOverhead(sizeof(Node));
+    usage.allocations = size + 2;
+    return usage;
+  }
+
   void append(const Type& item) {
-    tail->previous = new DataNode(item, tail->previous, tail);
+    tail->previous = createNode(item, tail->previous, tail);
     tail->previous->previous->next = tail->previous;
     ++size;
   }
 
   void prepend(const Type& item) {
-    head->next = new DataNode(item, head, head->next);
+    head->next = createNode(item, head, head->next);
     head->next->next->previous = head->next;
     ++size;
   }
 
   void insert(const const_iterator& insertPosition, const Type& item) {
-    DataNode* tmp = new DataNode(item, insertPosition.ptr->previous, insertPosition.ptr);
+    DataNode* tmp = createNode(item, insertPosition.ptr->previous, insertPosition.ptr);
     tmp->previous->next = tmp;
     tmp->next->previous = tmp;
     ++size;
@@ -134,7 +168,7 @@ public:
     Node* toDel = head->next;
     head->next = toDel->next;
     toDel->next->previous = head;
-    delete toDel;
+    destroyNode(toDel);
     --size;
     return tmp;
   }
@@ -147,7 +181,7 @@ public:
     Node* toDel = tail->previous;
     toDel->previous->next = tail;
     tail->previous = toDel->previous;
-    delete toDel;
+    destroyNode(toDel);
     --size;
     return tmp;
   }
@@ -161,7 +195,7 @@ public:
 
     toDel->previous->next = toDel->next;
     toDel->next->previous = toDel->previous;
-    delete toDel;
+    destroyNode(toDel);
     --size;
   }
 
@@ -172,15 +206,79 @@ public:
     Node* lastExcludedNode = lastExcluded.ptr;
     Node* tmp = firstIncluded.ptr;
     for(tmp = tmp->next; tmp != lastExcludedNode; tmp = tmp->next) {
-        delete tmp->previous;
+        destroyNode(tmp->previous);
       --size;
     }
-    delete tmp->previous;
+    destroyNode(tmp->previous);
     --size;
     beforeFirstINode->next = lastExcludedNode;
     lastExcludedNode->previous = beforeFirstINode;
   }
 
+  // Applies a batch of edits, sorted as Edits.h describes, in one forward
+  // walk: O(n + k) instead of a walk from the front per edit.
+  template <typename Edits>
+  void applyEdits(const Edits& edits) {
+    detail::checkEdits(edits, size);
+    Node* node = head->next;
+    size_type index = 0;
+    for(const auto& edit : edits) {
+      for(; index < edit.position; ++index)
+        node = node->next;
+      if(edit.op == EditOp::Insert) {
+        DataNode* inserted = createNode(edit.value, node->previous, node);
+        node->previous->next = inserted;
+        node->previous = inserted;
+        ++size;
+        continue;
+      }
+      Node* next = node->next;
+      if(edit.op == EditOp::Erase) {
+        node->previous->next = next;
+        next->previous = node->previous;
+        destroyNode(node);
+        --size;
+      }
+      else
+        static_cast<DataNode*>(node)->data = edit.value;
+      node = next;
+      ++index;
+    }
+  }
+
+  // Unlinks every element matching pred in one walk; returns how many.
+  template <typename Predicate>
+  size_type removeIf(Predicate pred) {
+    size_type removed = 0;
+    Node* node = head->next;
+    while(node != tail) {
+      Node* next = node->next;
+      if(pred(static_cast<const DataNode*>(node)->data)) {
+        node->previous->next = next;
+        next->previous = node->previous;
+        destroyNode(node);
+        ++removed;
+      }
+      node = next;
+    }
+    size -= removed;
+    return removed;
+  }
+
+  // Empties the list in O(1) and frees the detached nodes on the reclaimer's
+  // thread. Stats count the nodes as freed at the hand-over.
+  void destroyAsync(Reclaimer& reclaimer = Reclaimer::global()) {
+    if(isEmpty())
+      return;
+    Node* first = head->next;
+    tail->previous->next = nullptr;
+    head->next = tail;
+    tail->previous = head;
+    Stats::onNodesFreed(size);
+    size = 0;
+    reclaimer.submit([first] { destroyChain(first); });
+  }
+
   iterator begin() {
     return iterator(head->next);
   }
@@ -221,14 +319,34 @@ protected:
       this->next = n;
     }
   };
+
+  DataNode* createNode(const Type& item, Node* previous, Node* next) {
+    DataNode* node = new DataNode(item, previous, next);
+    Stats::onNodeAllocate();
+    return node;
+  }
+
+  void destroyNode(Node* node) { // Node has no virtual destructor
+    delete static_cast<DataNode*>(node);
+    Stats::onNodeFree();
+  }
+
+  static void destroyChain(Node* node) { // detached, ends with nullptr
+    while(node) {
+      Node* next = node->next;
+      delete static_cast<DataNode*>(node);
+      node = next;
+    }
+  }
+
   Node* head;
   Node* tail;
   size_type size;
 
 };
 
-template <typename Type>
-class LinkedList<Type>::ConstIterator {
+template <typename Type, typename Stats>
+class LinkedList<Type, Stats>::ConstIterator {
 
 public:
   using iterator_category = std::bidirectional_iterator_tag;
@@ -310,13 +428,13 @@ public:
 
 protected:
   Node* ptr;
-  friend void aisdi::LinkedList<Type>::insert(const const_iterator&, const Type&);
-  friend void aisdi::LinkedList<Type>::erase(const const_iterator& );
-  friend void aisdi::LinkedList<Type>::erase(const const_iterator&, const const_iterator& );
+  friend void aisdi::LinkedList<Type, Stats>::insert(const const_iterator&, const Type&);
+  friend void aisdi::LinkedList<Type, Stats>::erase(const const_iterator& );
+  friend void aisdi::LinkedList<Type, Stats>::erase(const const_iterator&, const const_iterator& );
 };
 
-template <typename Type>
-class LinkedList<Type>::Iterator : public LinkedList<Type>::ConstIterator
+template <typename Type, typename Stats>
+class LinkedList<Type, Stats>::Iterator : public LinkedList<Type, Stats>::ConstIterator
 {
 public:
   using pointer = typename LinkedList::pointer;
@@ -366,6 +484,12 @@ public:
 
 };
 
+template <typename Type, typename Stats, typename Predicate>
+typename LinkedList<Type, Stats>::size_type eraseIf(LinkedList<Type, Stats>& list, Predicate pred)
+{
+  return list.removeIf(pred);
+}
+
 }
 
 #endif // AISDI_LINEAR_LINKEDLIST_H
@@ -0,0 +1,408 @@
+#ifndef AISDI_LINEAR_MMAPVECTOR_H
+#define AISDI_LINEAR_MMAPVECTOR_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace aisdi
+{
+
+enum class MmapMode {
+  ReadOnly,  // file is never modified; writes through iterators stay private
+  ReadWrite, // opens an existing file or creates an empty one
+  Truncate   // always starts with an empty vector
+};
+
+// Vector whose buffer lives in a file mapped with mmap, so a dataset written
+// once is available again right after opening, without reading it in.
+// File layout: a 64 byte Header followed by capacity elements.
+// A moved-from MmapVector has no file: it reads as empty and throws
+// std::logic_error on modification.
+template <typename Type>
+class MmapVector
+{
+  static_assert(std::is_trivially_copyable<Type>::value,
+                "MmapVector can only store trivially copyable types");
+
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = Type;
+  using pointer = Type*;
+  using reference = Type&;
+  using const_pointer = const Type*;
+  using const_reference = const Type&;
+
+  class ConstIterator;
+  class Iterator;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  using Mode = MmapMode;
+
+  static const std::uint32_t VERSION = 1;
+  static const size_type START_CAPACITY = 1024;
+
+  explicit MmapVector(const std::string& path, Mode mode = Mode::ReadWrite)
+    : fd(-1), mapping(nullptr), mappedBytes(0), readOnly(mode == Mode::ReadOnly) {
+    int flags = readOnly ? O_RDONLY : O_RDWR | O_CREAT;
+    if(mode == Mode::Truncate)
+      flags |= O_TRUNC;
+    fd = ::open(path.c_str(), flags, 0644);
+    if(fd < 0)
+      throw std::system_error(errno, std::generic_category(), "open " + path);
+    try {
+      struct stat info;
+      if(::fstat(fd, &info) != 0)
+        throw std::system_error(errno, std::generic_category(), "fstat " + path);
+      if(info.st_size == 0 && !readOnly)
+        initialize();
+      else {
+        map(static_cast<size_type>(info.st_size));
+        validate();
+      }
+    }
+    catch(...) {
+      unmap();
+      ::close(fd);
+      throw;
+    }
+  }
+
+  MmapVector(const MmapVector&) = delete;
+  MmapVector& operator=(const MmapVector&) = delete;
+
+  MmapVector(MmapVector&& other)
+    : fd(other.fd), mapping(other.mapping), mappedBytes(other.mappedBytes), readOnly(other.readOnly) {
+    other.fd = -1;
+    other.mapping = nullptr;
+    other.mappedBytes = 0;
+  }
+
+  MmapVector& operator=(MmapVector&& other) {
+    if(this == &other)
+      return *this;
+    close();
+    fd = other.fd;
+    mapping = other.mapping;
+    mappedBytes = other.mappedBytes;
+    readOnly = other.readOnly;
+    other.fd = -1;
+    other.mapping = nullptr;
+    other.mappedBytes = 0;
+    return *this;
+  }
+
+  ~MmapVector() {
+    close();
+  }
+
+  bool isEmpty() const {
+    return !getSize();
+  }
+
+  size_type getSize() const {
+    return mapping ? header()->size : 0;
+  }
+
+  size_type getCapacity() const {
+    return mapping ? header()->capacity : 0;
+  }
+
+  bool isReadOnly() const {
+    return readOnly;
+  }
+
+  pointer data() {
+    return reinterpret_cast<Type*>(static_cast<char*>(mapping) + DATA_OFFSET);
+  }
+
+  const_pointer data() const {
+    return reinterpret_cast<const Type*>(static_cast<const char*>(mapping) + DATA_OFFSET);
+  }
+
+  void reserve(size_type newCapacity) { // never shrinks
+    checkWritable();
+    if(newCapacity <= getCapacity())
+      return;
+    if(newCapacity > (static_cast<size_type>(std::numeric_limits<off_t>::max()) - DATA_OFFSET) / sizeof(Type))
+      throw std::out_of_range("Attempt to reserve more than a file can hold");
+    size_type newBytes = DATA_OFFSET + newCapacity * sizeof(Type);
+    if(::ftruncate(fd, static_cast<off_t>(newBytes)) != 0)
+      throw std::system_error(errno, std::generic_category(), "ftruncate");
+    void* moved = ::mremap(mapping, mappedBytes, newBytes, MREMAP_MAYMOVE);
+    if(moved == MAP_FAILED)
+      throw std::system_error(errno, std::generic_category(), "mremap");
+    mapping = moved;
+    mappedBytes = newBytes;
+    header()->capacity = newCapacity;
+  }
+
+  void append(const Type& item) {
+    checkWritable();
+    if(getSize() == getCapacity()) {
+      Type copy = item; // item may live in the mapping that is about to move
+      reserve(2 * getCapacity() < START_CAPACITY ? START_CAPACITY : 2 * getCapacity());
+      data()[header()->size++] = copy;
+      return;
+    }
+    data()[header()->size++] = item;
+  }
+
+  Type popLast() {
+    checkWritable();
+    if(isEmpty())
+      throw std::logic_error("Attempt to pop last in empty vector");
+    return data()[--header()->size];
+  }
+
+  // Writes dirty pages back to the file; blocks until they are on disk.
+  void flush() {
+    if(readOnly || !mapping)
+      return;
+    if(::msync(mapping, mappedBytes, MS_SYNC) != 0)
+      throw std::system_error(errno, std::generic_category(), "msync");
+  }
+
+  iterator begin() {
+    return iterator(0, this);
+  }
+
+  iterator end() {
+    return iterator(getSize(), this);
+  }
+
+  const_iterator cbegin() const {
+    return const_iterator(0, this);
+  }
+
+  const_iterator cend() const {
+    return const_iterator(getSize(), this);
+  }
+
+  const_iterator begin() const {
+    return cbegin();
+  }
+
+  const_iterator end() const {
+    return cend();
+  }
+
+private:
+  struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t typeSize;
+    std::uint64_t size;
+    std::uint64_t capacity;
+  };
+  static const size_type DATA_OFFSET = 64;
+  static_assert(sizeof(Header) <= DATA_OFFSET, "Header must fit before the data");
+
+  static const char* magic() {
+    return "AISDIMV";
+  }
+
+  Header* header() {
+    return static_cast<Header*>(mapping);
+  }
+
+  const Header* header() const {
+    return static_cast<const Header*>(mapping);
+  }
+
+  void initialize() {
+    size_type bytes = DATA_OFFSET + START_CAPACITY * sizeof(Type);
+    if(::ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+      throw std::system_error(errno, std::generic_category(), "ftruncate");
+    map(bytes);
+    std::memcpy(header()->magic, magic(), sizeof(header()->magic));
+    header()->version = VERSION;
+    header()->typeSize = sizeof(Type);
+    header()->size = 0;
+    header()->capacity = START_CAPACITY;
+  }
+
+  void map(size_type bytes) {
+    if(bytes < DATA_OFFSET)
+      throw std::runtime_error("MmapVector file is too small");
+    int protection = PROT_READ | PROT_WRITE;
+    int flags = readOnly ? MAP_PRIVATE : MAP_SHARED;
+    void* result = ::mmap(nullptr, bytes, protection, flags, fd, 0);
+    if(result == MAP_FAILED)
+      throw std::system_error(errno, std::generic_category(), "mmap");
+    mapping = result;
+    mappedBytes = bytes;
+  }
+
+  void validate() const {
+    const Header* h = header();
+    if(std::memcmp(h->magic, magic(), sizeof(h->magic)) != 0)
+      throw std::runtime_error("MmapVector file has a wrong magic number");
+    if(h->version != VERSION)
+      throw std::runtime_error("MmapVector file has an unsupported version");
+    if(h->typeSize != sizeof(Type))
+      throw std::runtime_error("MmapVector file holds elements of a different size");
+    if(!h->capacity || h->size > h->capacity || h->capacity > (mappedBytes - DATA_OFFSET) / sizeof(Type))
+      throw std::runtime_error("MmapVector file is truncated or corrupted");
+  }
+
+  void checkWritable() const {
+    if(!mapping)
+      throw std::logic_error("Attempt to modify moved-from vector");
+    if(readOnly)
+      throw std::logic_error("Attempt to modify read-only vector");
+  }
+
+  void unmap() {
+    if(mapping)
+      ::munmap(mapping, mappedBytes);
+    mapping = nullptr;
+    mappedBytes = 0;
+  }
+
+  void close() {
+    unmap();
+    if(fd >= 0)
+      ::close(fd);
+    fd = -1;
+  }
+
+  int fd;
+  void* mapping;
+  size_type mappedBytes;
+  bool readOnly;
+};
+
+template <typename Type>
+class MmapVector<Type>::ConstIterator
+{
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename MmapVector::value_type;
+  using difference_type = typename MmapVector::difference_type;
+  using pointer = typename MmapVector::const_pointer;
+  using reference = typename MmapVector::const_reference;
+
+  explicit ConstIterator(size_type i = 0, const MmapVector* v = nullptr) : index(i), vec(v) {}
+
+  reference operator*() const {
+    if(index >= vec->getSize())
+      throw std::out_of_range("Attempt to dereference end iterator");
+    return vec->data()[index];
+  }
+
+  ConstIterator& operator++() {
+    if(index == vec->getSize())
+      throw std::out_of_range("Attempt to increment end iterator");
+    ++index;
+    return *this;
+  }
+
+  ConstIterator operator++(int) {
+    ConstIterator result = *this;
+    operator++();
+    return result;
+  }
+
+  ConstIterator& operator--() {
+    if(index == 0)
+      throw std::out_of_range("Attempt to decrement begin iterator");
+    --index;
+    return *this;
+  }
+
+  ConstIterator operator--(int) {
+    ConstIterator result = *this;
+    operator--();
+    return result;
+  }
+
+  ConstIterator operator+(difference_type d) const {
+    if(index + d > vec->getSize())
+      throw std::out_of_range("Attempt to add out of vector range");
+    return ConstIterator(index + d, vec);
+  }
+
+  ConstIterator operator-(difference_type d) const {
+    if(d > static_cast<difference_type>(index))
+      throw std::out_of_range("Attempt to substract out of vector range");
+    return ConstIterator(index - d, vec);
+  }
+
+  bool operator==(const ConstIterator& other) const {
+    return vec == other.vec && index == other.index;
+  }
+
+  bool operator!=(const ConstIterator& other) const {
+    return !operator==(other);
+  }
+
+protected:
+  size_type index;
+  const MmapVector* vec;
+};
+
+template <typename Type>
+class MmapVector<Type>::Iterator : public MmapVector<Type>::ConstIterator
+{
+public:
+  using pointer = typename MmapVector::pointer;
+  using reference = typename MmapVector::reference;
+
+  explicit Iterator(size_type i, const MmapVector* v) : ConstIterator(i, v) {}
+
+  Iterator(const ConstIterator& other)
+    : ConstIterator(other) {}
+
+  Iterator& operator++() {
+    ConstIterator::operator++();
+    return *this;
+  }
+
+  Iterator operator++(int) {
+    auto result = *this;
+    ConstIterator::operator++();
+    return result;
+  }
+
+  Iterator& operator--() {
+    ConstIterator::operator--();
+    return *this;
+  }
+
+  Iterator operator--(int) {
+    auto result = *this;
+    ConstIterator::operator--();
+    return result;
+  }
+
+  Iterator operator+(difference_type d) const {
+    return ConstIterator::operator+(d);
+  }
+
+  Iterator operator-(difference_type d) const {
+    return ConstIterator::operator-(d);
+  }
+
+  reference operator*() const {
+    // ugly cast, yet reduces code duplication.
+    return const_cast<reference>(ConstIterator::operator*());
+  }
+};
+
+}
+
+#endif // AISDI_LINEAR_MMAPVECTOR_H
@@ -0,0 +1,184 @@
+#ifndef AISDI_LINEAR_PERFCOUNTERS_H
+#define AISDI_LINEAR_PERFCOUNTERS_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace aisdi
+{
+
+// Hardware counters read around a region of code with perf_event_open. Each
+// event is opened on its own, so a kernel or CPU that refuses some of them
+// (perf_event_paranoid, virtual machines without a PMU) still yields the rest;
+// with none available, start() and stop() are no-ops and samples are empty.
+// Counts are scaled when the kernel multiplexes events.
+class PerfCounters
+{
+public:
+  enum Event {
+    CYCLES,
+    INSTRUCTIONS,
+    L1D_MISSES,
+    LLC_MISSES,
+    BRANCH_MISSES,
+    DTLB_MISSES,
+    EVENT_COUNT
+  };
+
+  struct Sample {
+    double values[EVENT_COUNT];
+    bool valid[EVENT_COUNT];
+
+    Sample() {
+      for(int i = 0; i < EVENT_COUNT; ++i) {
+        values[i] = 0;
+        valid[i] = false;
+      }
+    }
+
+    bool isEmpty() const {
+      for(int i = 0; i < EVENT_COUNT; ++i)
+        if(valid[i])
+          return false;
+      return true;
+    }
+  };
+
+  PerfCounters() : lastError(0) {
+    for(int i = 0; i < EVENT_COUNT; ++i)
+      fds[i] = open(static_cast<Event>(i));
+  }
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  ~PerfCounters() {
+    for(int i = 0; i < EVENT_COUNT; ++i)
+      if(fds[i] >= 0)
+        ::close(fds[i]);
+  }
+
+  static const char* eventName(Event event) {
+    static const char* const names[EVENT_COUNT] = {
+      "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses"
+    };
+    return names[event];
+  }
+
+  bool isAvailable() const {
+    for(int i = 0; i < EVENT_COUNT; ++i)
+      if(fds[i] >= 0)
+        return true;
+    return false;
+  }
+
+  bool isAvailable(Event event) const {
+    return fds[event] >= 0;
+  }
+
+  // Why events could not be opened, for a one-line warning.
+  std::string unavailableReason() const {
+    if(!lastError)
+      return std::string();
+    if(lastError == ENOENT || lastError == EOPNOTSUPP)
+      return "events not supported by this CPU or kernel";
+    std::string reason = std::strerror(lastError);
+    if(lastError == EACCES || lastError == EPERM) {
+      std::ifstream paranoid("/proc/sys/kernel/perf_event_paranoid");
+      std::string level;
+      if(paranoid >> level)
+        reason += " (perf_event_paranoid=" + level + ")";
+    }
+    return reason;
+  }
+
+  void start() {
+    for(int i = 0; i < EVENT_COUNT; ++i)
+      if(fds[i] >= 0) {
+        ::ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+        ::ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+      }
+  }
+
+  Sample stop() {
+    for(int i = 0; i < EVENT_COUNT; ++i)
+      if(fds[i] >= 0)
+        ::ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+    Sample sample;
+    for(int i = 0; i < EVENT_COUNT; ++i) {
+      ReadFormat result;
+      if(fds[i] < 0 || ::read(fds[i], &result, sizeof(result)) != sizeof(result) || !result.running)
+        continue;
+      sample.values[i] = static_cast<double>(result.value) * result.enabled / result.running;
+      sample.valid[i] = true;
+    }
+    return sample;
+  }
+
+private:
+  struct ReadFormat {
+    std::uint64_t value;
+    std::uint64_t enabled;
+    std::uint64_t running;
+  };
+
+  static std::uint64_t cacheMiss(std::uint64_t cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  }
+
+  int open(Event event) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    switch(event) {
+      case CYCLES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+      case INSTRUCTIONS:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+      case L1D_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = cacheMiss(PERF_COUNT_HW_CACHE_L1D);
+        break;
+      case LLC_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = cacheMiss(PERF_COUNT_HW_CACHE_LL);
+        break;
+      case BRANCH_MISSES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+      default:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = cacheMiss(PERF_COUNT_HW_CACHE_DTLB);
+        break;
+    }
+    int fd = static_cast<int>(::syscall(__NR_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+    if(fd < 0)
+      lastError = errno;
+    return fd;
+  }
+
+  int fds[EVENT_COUNT];
+  int lastError;
+};
+
+}
+
+#endif // AISDI_LINEAR_PERFCOUNTERS_H
@@ -0,0 +1,432 @@
+#ifndef AISDI_LINEAR_PERSISTENTVECTOR_H
+#define AISDI_LINEAR_PERSISTENTVECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+
+namespace aisdi
+{
+
+// Immutable vector: a 32-way radix trie whose last (possibly partial) leaf is
+// kept aside as the tail. append/set/popLast return a new version that shares
+// every node not on the modified path, so copies are O(1) and updates are
+// O(log32 n). Versions may be read from many threads at once.
+template <typename Type>
+class PersistentVector
+{
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = Type;
+  using const_pointer = const Type*;
+  using const_reference = const Type&;
+
+  class ConstIterator;
+  class Transient;
+  using const_iterator = ConstIterator;
+  using iterator = ConstIterator;
+
+  PersistentVector() : trie(0) {}
+
+  PersistentVector(std::initializer_list<Type> l) : PersistentVector() {
+    Transient builder = transient();
+    for(auto it = l.begin(); it != l.end(); ++it)
+      builder.append(*it);
+    *this = builder.persistent();
+  }
+
+  bool isEmpty() const {
+    return !trie.size;
+  }
+
+  size_type getSize() const {
+    return trie.size;
+  }
+
+  const Type& at(size_type index) const {
+    if(index >= trie.size)
+      throw std::out_of_range("Attempt to access out of vector range");
+    return trie.leafFor(index)[index & MASK];
+  }
+
+  PersistentVector append(const Type& item) const {
+    PersistentVector result = *this;
+    result.trie.append(item, 0);
+    return result;
+  }
+
+  PersistentVector set(size_type index, const Type& item) const {
+    if(index >= trie.size)
+      throw std::out_of_range("Attempt to set out of vector range");
+    PersistentVector result = *this;
+    result.trie.set(index, item, 0);
+    return result;
+  }
+
+  PersistentVector popLast() const {
+    if(isEmpty())
+      throw std::logic_error("Attempt to pop last in empty vector");
+    PersistentVector result = *this;
+    result.trie.popLast(0);
+    return result;
+  }
+
+  // Batch builder for bulk construction; see Transient.
+  Transient transient() const {
+    return Transient(trie);
+  }
+
+  const_iterator cbegin() const {
+    return const_iterator(0, this);
+  }
+
+  const_iterator cend() const {
+    return const_iterator(trie.size, this);
+  }
+
+  const_iterator begin() const {
+    return cbegin();
+  }
+
+  const_iterator end() const {
+    return cend();
+  }
+
+private:
+  static const unsigned BITS = 5;
+  static const size_type WIDTH = 1 << BITS;
+  static const size_type MASK = WIDTH - 1;
+
+  // owner is the id of the transient allowed to change the node in place,
+  // 0 for nodes that are (or may be) shared between versions.
+  struct Node {
+    std::uint64_t owner;
+    explicit Node(std::uint64_t o) : owner(o) {}
+  };
+  struct Branch : Node {
+    std::shared_ptr<Node> children[WIDTH];
+    explicit Branch(std::uint64_t o) : Node(o) {}
+  };
+  struct Leaf : Node {
+    Type values[WIDTH];
+    explicit Leaf(std::uint64_t o) : Node(o) {}
+  };
+
+  struct Trie {
+    size_type size;
+    unsigned shift;
+    std::shared_ptr<Branch> root;
+    std::shared_ptr<Leaf> tail;
+
+    explicit Trie(std::uint64_t edit)
+      : size(0), shift(BITS), root(std::make_shared<Branch>(edit)), tail(std::make_shared<Leaf>(edit)) {}
+
+    size_type tailOffset() const {
+      return size < WIDTH ? 0 : ((size - 1) >> BITS) << BITS;
+    }
+
+    const Type* leafFor(size_type index) const {
+      if(index >= tailOffset())
+        return tail->values;
+      const Node* node = root.get();
+      for(unsigned level = shift; level > 0; level -= BITS)
+        node = static_cast<const Branch*>(node)->children[(index >> level) & MASK].get();
+      return static_cast<const Leaf*>(node)->values;
+    }
+
+    template <typename NodeType>
+    static std::shared_ptr<NodeType> editable(const std::shared_ptr<NodeType>& node, std::uint64_t edit) {
+      if(edit && node->owner == edit)
+        return node;
+      std::shared_ptr<NodeType> copy = std::make_shared<NodeType>(*node);
+      copy->owner = edit;
+      return copy;
+    }
+
+    static std::shared_ptr<Node> newPath(unsigned level, const std::shared_ptr<Node>& node, std::uint64_t edit) {
+      if(level == 0)
+        return node;
+      std::shared_ptr<Branch> branch = std::make_shared<Branch>(edit);
+      branch->children[0] = newPath(level - BITS, node, edit);
+      return branch;
+    }
+
+    std::shared_ptr<Branch> pushTail(unsigned level, const std::shared_ptr<Branch>& parent,
+                                     const std::shared_ptr<Node>& tailNode, std::uint64_t edit) {
+      size_type subIndex = ((size - 1) >> level) & MASK;
+      std::shared_ptr<Branch> result = editable(parent, edit);
+      std::shared_ptr<Node> inserted;
+      if(level == BITS)
+        inserted = tailNode;
+      else if(parent->children[subIndex])
+        inserted = pushTail(level - BITS, std::static_pointer_cast<Branch>(parent->children[subIndex]),
+                            tailNode, edit);
+      else
+        inserted = newPath(level - BITS, tailNode, edit);
+      result->children[subIndex] = inserted;
+      return result;
+    }
+
+    // Returns nullptr when the subtree becomes empty.
+    std::shared_ptr<Branch> popTail(unsigned level, const std::shared_ptr<Branch>& node, std::uint64_t edit) {
+      size_type subIndex = ((size - 2) >> level) & MASK;
+      if(level > BITS) {
+        std::shared_ptr<Branch> child =
+          popTail(level - BITS, std::static_pointer_cast<Branch>(node->children[subIndex]), edit);
+        if(!child && subIndex == 0)
+          return nullptr;
+        std::shared_ptr<Branch> result = editable(node, edit);
+        result->children[subIndex] = child;
+        return result;
+      }
+      if(subIndex == 0)
+        return nullptr;
+      std::shared_ptr<Branch> result = editable(node, edit);
+      result->children[subIndex] = nullptr;
+      return result;
+    }
+
+    std::shared_ptr<Node> doSet(unsigned level, const std::shared_ptr<Node>& node, size_type index,
+                                const Type& item, std::uint64_t edit) {
+      if(level == 0) {
+        std::shared_ptr<Leaf> leaf = editable(std::static_pointer_cast<Leaf>(node), edit);
+        leaf->values[index & MASK] = item;
+        return leaf;
+      }
+      std::shared_ptr<Branch> branch = editable(std::static_pointer_cast<Branch>(node), edit);
+      size_type subIndex = (index >> level) & MASK;
+      branch->children[subIndex] = doSet(level - BITS, branch->children[subIndex], index, item, edit);
+      return branch;
+    }
+
+    void append(const Type& item, std::uint64_t edit) {
+      if(size - tailOffset() < WIDTH) {
+        tail = editable(tail, edit);
+        tail->values[size - tailOffset()] = item;
+        ++size;
+        return;
+      }
+      if((size >> BITS) > (size_type(1) << shift)) { // root is full, grow a level
+        std::shared_ptr<Branch> newRoot = std::make_shared<Branch>(edit);
+        newRoot->children[0] = root;
+        newRoot->children[1] = newPath(shift, tail, edit);
+        root = newRoot;
+        shift += BITS;
+      }
+      else
+        root = pushTail(shift, root, tail, edit);
+      tail = std::make_shared<Leaf>(edit);
+      tail->values[0] = item;
+      ++size;
+    }
+
+    void set(size_type index, const Type& item, std::uint64_t edit) {
+      if(index >= tailOffset()) {
+        tail = editable(tail, edit);
+        tail->values[index & MASK] = item;
+      }
+      else
+        root = std::static_pointer_cast<Branch>(doSet(shift, root, index, item, edit));
+    }
+
+    void popLast(std::uint64_t edit) {
+      if(size == 1) {
+        *this = Trie(edit);
+        return;
+      }
+      if(size - tailOffset() > 1) {
+        tail = editable(tail, edit);
+        tail->values[(size - 1) & MASK] = Type();
+        --size;
+        return;
+      }
+      std::shared_ptr<Leaf> newTail = findLeaf(size - 2);
+      std::shared_ptr<Branch> newRoot = popTail(shift, root, edit);
+      if(!newRoot)
+        newRoot = std::make_shared<Branch>(edit);
+      if(shift > BITS && !newRoot->children[1]) {
+        newRoot = std::static_pointer_cast<Branch>(newRoot->children[0]);
+        shift -= BITS;
+      }
+      root = newRoot;
+      tail = newTail;
+      --size;
+    }
+
+    std::shared_ptr<Leaf> findLeaf(size_type index) const {
+      std::shared_ptr<Node> node = root;
+      for(unsigned level = shift; level > 0; level -= BITS)
+        node = static_cast<const Branch*>(node.get())->children[(index >> level) & MASK];
+      return std::static_pointer_cast<Leaf>(node);
+    }
+  };
+
+  static std::uint64_t nextEditId() {
+    static std::atomic<std::uint64_t> lastId(0);
+    return ++lastId;
+  }
+
+  explicit PersistentVector(const Trie& t) : trie(t) {}
+
+  Trie trie;
+};
+
+// Mutable builder: nodes created by this transient are changed in place
+// instead of being path-copied. persistent() publishes the current state and
+// retires the id, so later edits never touch the published nodes.
+template <typename Type>
+class PersistentVector<Type>::Transient
+{
+public:
+  // Copies would share the edit id and mutate each other's nodes in place.
+  Transient(const Transient&) = delete;
+  Transient& operator=(const Transient&) = delete;
+
+  Transient(Transient&& other) : trie(other.trie), edit(other.edit) {
+    other.reset();
+  }
+
+  Transient& operator=(Transient&& other) {
+    if(this == &other)
+      return *this;
+    trie = other.trie;
+    edit = other.edit;
+    other.reset();
+    return *this;
+  }
+
+  bool isEmpty() const {
+    return !trie.size;
+  }
+
+  size_type getSize() const {
+    return trie.size;
+  }
+
+  const Type& at(size_type index) const {
+    if(index >= trie.size)
+      throw std::out_of_range("Attempt to access out of vector range");
+    return trie.leafFor(index)[index & MASK];
+  }
+
+  Transient& append(const Type& item) {
+    trie.append(item, edit);
+    return *this;
+  }
+
+  Transient& set(size_type index, const Type& item) {
+    if(index >= trie.size)
+      throw std::out_of_range("Attempt to set out of vector range");
+    trie.set(index, item, edit);
+    return *this;
+  }
+
+  Transient& popLast() {
+    if(isEmpty())
+      throw std::logic_error("Attempt to pop last in empty vector");
+    trie.popLast(edit);
+    return *this;
+  }
+
+  PersistentVector persistent() {
+    edit = nextEditId();
+    return PersistentVector(trie);
+  }
+
+private:
+  friend class PersistentVector;
+
+  explicit Transient(const Trie& t) : trie(t), edit(nextEditId()) {}
+
+  void reset() { // leaves a moved-from transient empty and usable
+    trie = Trie(0);
+    edit = nextEditId();
+  }
+
+  Trie trie;
+  std::uint64_t edit;
+};
+
+template <typename Type>
+class PersistentVector<Type>::ConstIterator
+{
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename PersistentVector::value_type;
+  using difference_type = typename PersistentVector::difference_type;
+  using pointer = typename PersistentVector::const_pointer;
+  using reference = typename PersistentVector::const_reference;
+
+  explicit ConstIterator(size_type i = 0, const PersistentVector* v = nullptr)
+    : index(i), vec(v), leaf(nullptr), leafBase(0) {}
+
+  reference operator*() const {
+    if(index >= vec->trie.size)
+      throw std::out_of_range("Attempt to dereference end iterator");
+    if(!leaf || index - leafBase >= WIDTH) { // walk the trie once per leaf
+      leafBase = index & ~MASK;
+      leaf = vec->trie.leafFor(index);
+    }
+    return leaf[index - leafBase];
+  }
+
+  ConstIterator& operator++() {
+    if(index == vec->trie.size)
+      throw std::out_of_range("Attempt to increment end iterator");
+    ++index;
+    return *this;
+  }
+
+  ConstIterator operator++(int) {
+    ConstIterator result = *this;
+    operator++();
+    return result;
+  }
+
+  ConstIterator& operator--() {
+    if(index == 0)
+      throw std::out_of_range("Attempt to decrement begin iterator");
+    --index;
+    return *this;
+  }
+
+  ConstIterator operator--(int) {
+    ConstIterator result = *this;
+    operator--();
+    return result;
+  }
+
+  ConstIterator operator+(difference_type d) const {
+    if(index + d > vec->trie.size)
+      throw std::out_of_range("Attempt to add out of vector range");
+    return ConstIterator(index + d, vec);
+  }
+
+  ConstIterator operator-(difference_type d) const {
+    if(d > static_cast<difference_type>(index))
+      throw std::out_of_range("Attempt to substract out of vector range");
+    return ConstIterator(index - d, vec);
+  }
+
+  bool operator==(const ConstIterator& other) const {
+    return vec == other.vec && index == other.index;
+  }
+
+  bool operator!=(const ConstIterator& other) const {
+    return !operator==(other);
+  }
+
+private:
+  size_type index;
+  const PersistentVector* vec;
+  mutable const Type* leaf;
+  mutable size_type leafBase;
+};
+
+}
+
+#endif // AISDI_LINEAR_PERSISTENTVECTOR_H
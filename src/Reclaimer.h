@@ -0,0 +1,137 @@
+#ifndef AISDI_LINEAR_RECLAIMER_H
+#define AISDI_LINEAR_RECLAIMER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "BufferCache.h"
+
+namespace aisdi
+{
+
+// Background thread that runs deallocation jobs, used by destroyAsync() of
+// Vector and LinkedList so a thread dropping a 50M-node list hands the node
+// chain over in O(1) instead of freeing it on the spot. The queue holds at
+// most maxQueued jobs; submit blocks while it is full, so a producer cannot
+// pile up unbounded garbage. flush() waits until every job submitted so far
+// has run, e.g. before shutdown or before measuring memory; the destructor
+// flushes and joins the thread. Jobs submitted from the reclaimer's own
+// thread, or that cannot be queued, run inline, and flush() called by a job
+// runs the queued jobs itself instead of waiting for its own thread. The
+// thread's BufferCache is kept off so freed buffers go back to the allocator.
+class Reclaimer
+{
+public:
+  static const std::size_t DEFAULT_QUEUE_DEPTH = 64;
+
+  explicit Reclaimer(std::size_t maxQueued = DEFAULT_QUEUE_DEPTH)
+    : limit(maxQueued), running(false), stopping(false), completed(0) {
+    if(!maxQueued)
+      throw std::out_of_range("Reclaimer queue depth must be positive");
+    worker = std::thread(&Reclaimer::run, this);
+  }
+
+  Reclaimer(const Reclaimer&) = delete;
+  Reclaimer& operator=(const Reclaimer&) = delete;
+
+  ~Reclaimer() {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wakeWorker.notify_one();
+    worker.join();
+  }
+
+  // Shared instance the containers use by default.
+  static Reclaimer& global() {
+    static Reclaimer reclaimer;
+    return reclaimer;
+  }
+
+  template <typename Job>
+  void submit(Job job) {
+    if(std::this_thread::get_id() == worker.get_id()) {
+      job();
+      return;
+    }
+    try {
+      std::function<void()> queued(job);
+      std::unique_lock<std::mutex> lock(mutex);
+      wakeProducer.wait(lock, [this] { return jobs.size() < limit; });
+      jobs.push_back(std::move(queued));
+    }
+    catch(...) { // no memory for the queue entry: free right here instead
+      job();
+      return;
+    }
+    wakeWorker.notify_one();
+  }
+
+  // Waits until every job submitted before the call has run.
+  void flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if(std::this_thread::get_id() == worker.get_id()) {
+      while(!jobs.empty())
+        runFront(lock);
+      return;
+    }
+    std::size_t target = completed + jobs.size() + (running ? 1 : 0);
+    wakeProducer.wait(lock, [this, target] { return completed >= target; });
+  }
+
+  std::size_t pending() const { // queued or running
+    std::unique_lock<std::mutex> lock(mutex);
+    return jobs.size() + (running ? 1 : 0);
+  }
+
+  std::size_t getQueueDepth() const {
+    return limit;
+  }
+
+private:
+  void run() {
+    if(BufferCache* cache = BufferCache::local())
+      cache->setCapacity(0);
+    std::unique_lock<std::mutex> lock(mutex);
+    for(;;) {
+      wakeWorker.wait(lock, [this] { return stopping || !jobs.empty(); });
+      if(jobs.empty())
+        return;
+      running = true;
+      runFront(lock);
+      running = false;
+    }
+  }
+
+  // Runs the oldest job with the lock released; returns with it held.
+  void runFront(std::unique_lock<std::mutex>& lock) {
+    std::function<void()> job = std::move(jobs.front());
+    jobs.pop_front();
+    lock.unlock();
+    job();
+    job = nullptr;
+    lock.lock();
+    ++completed;
+    wakeProducer.notify_all();
+  }
+
+  mutable std::mutex mutex;
+  std::condition_variable wakeWorker;   // a job arrived or stopping
+  std::condition_variable wakeProducer; // a job finished, so space freed up
+  std::deque<std::function<void()>> jobs;
+  std::size_t limit;
+  bool running;
+  bool stopping;
+  std::size_t completed;
+  std::thread worker;
+};
+
+}
+
+#endif // AISDI_LINEAR_RECLAIMER_H
@@ -0,0 +1,256 @@
+#ifndef AISDI_LINEAR_SERIALIZATION_H
+#define AISDI_LINEAR_SERIALIZATION_H
+
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "LinkedList.h"
+#include "Vector.h"
+
+// Binary format shared by both containers (native byte order):
+//   StreamHeader, then count elements of typeSize bytes each.
+// A stream written from a Vector can be read into a LinkedList and back.
+
+namespace aisdi
+{
+namespace detail
+{
+
+struct StreamHeader {
+  char magic[4];
+  std::uint16_t version;
+  std::uint16_t reserved;
+  std::uint32_t typeSize;
+  std::uint32_t reserved2;
+  std::uint64_t count;
+};
+
+const std::uint16_t STREAM_VERSION = 1;
+const std::size_t WRITEV_BATCH = 1024;         // iovecs per writev, within IOV_MAX
+const std::size_t STREAM_CHUNK_BYTES = 1 << 16; // read granularity
+
+inline StreamHeader makeStreamHeader(std::size_t typeSize, std::size_t count) {
+  StreamHeader header;
+  std::memcpy(header.magic, "AISL", 4);
+  header.version = STREAM_VERSION;
+  header.reserved = 0;
+  header.typeSize = static_cast<std::uint32_t>(typeSize);
+  header.reserved2 = 0;
+  header.count = count;
+  return header;
+}
+
+// Writes every iovec, resuming after partial writes and EINTR.
+inline void writeAll(int fd, iovec* vectors, std::size_t count) {
+  while(count) {
+    ssize_t written = ::writev(fd, vectors, static_cast<int>(count < WRITEV_BATCH ? count : WRITEV_BATCH));
+    if(written < 0) {
+      if(errno == EINTR)
+        continue;
+      throw std::system_error(errno, std::generic_category(), "writev");
+    }
+    std::size_t left = static_cast<std::size_t>(written);
+    while(count && left >= vectors->iov_len) {
+      left -= vectors->iov_len;
+      ++vectors;
+      --count;
+    }
+    if(count) {
+      vectors->iov_base = static_cast<char*>(vectors->iov_base) + left;
+      vectors->iov_len -= left;
+    }
+  }
+}
+
+// Reads exactly bytes unless the stream ends first; returns what was read.
+inline std::size_t readAll(int fd, void* buffer, std::size_t bytes) {
+  std::size_t done = 0;
+  while(done < bytes) {
+    ssize_t got = ::read(fd, static_cast<char*>(buffer) + done, bytes - done);
+    if(got < 0) {
+      if(errno == EINTR)
+        continue;
+      throw std::system_error(errno, std::generic_category(), "read");
+    }
+    if(got == 0)
+      break;
+    done += static_cast<std::size_t>(got);
+  }
+  return done;
+}
+
+// Bytes left to read when fd is a regular file, or -1 when that is unknown
+// (pipes, sockets).
+inline off_t bytesLeft(int fd) {
+  struct stat status;
+  if(::fstat(fd, &status) != 0 || !S_ISREG(status.st_mode))
+    return -1;
+  off_t position = ::lseek(fd, 0, SEEK_CUR);
+  if(position < 0)
+    return -1;
+  return status.st_size > position ? status.st_size - position : 0;
+}
+
+inline std::uint64_t readStreamHeader(int fd, std::size_t typeSize) {
+  StreamHeader header;
+  if(readAll(fd, &header, sizeof(header)) != sizeof(header))
+    throw std::runtime_error("Stream ended inside the header");
+  if(std::memcmp(header.magic, "AISL", 4) != 0)
+    throw std::runtime_error("Stream has a wrong magic number");
+  if(header.version != STREAM_VERSION)
+    throw std::runtime_error("Stream has an unsupported version");
+  if(header.typeSize != typeSize)
+    throw std::runtime_error("Stream holds elements of a different size");
+  return header.count;
+}
+
+}
+
+// Decodes a serialized container chunk by chunk, so arbitrarily long streams
+// can be consumed in bounded memory.
+template <typename Type>
+class StreamReader
+{
+  static_assert(std::is_trivially_copyable<Type>::value,
+                "Only trivially copyable types can be deserialized");
+
+public:
+  using size_type = std::size_t;
+
+  static const size_type CHUNK_SIZE =
+    detail::STREAM_CHUNK_BYTES / sizeof(Type) ? detail::STREAM_CHUNK_BYTES / sizeof(Type) : 1;
+
+  explicit StreamReader(int descriptor)
+    : fd(descriptor), total(detail::readStreamHeader(descriptor, sizeof(Type))), left(total) {}
+
+  size_type getSize() const {
+    return total;
+  }
+
+  size_type remaining() const {
+    return left;
+  }
+
+  // Reads up to maxCount elements into out, returns how many were read.
+  size_type read(Type* out, size_type maxCount) {
+    size_type count = maxCount < left ? maxCount : left;
+    size_type bytes = count * sizeof(Type);
+    if(detail::readAll(fd, out, bytes) != bytes)
+      throw std::runtime_error("Stream ended before all elements were read");
+    left -= count;
+    return count;
+  }
+
+  // Decodes the next chunk and appends it to collection; false at the end.
+  template <typename Collection>
+  bool readChunk(Collection& collection) {
+    if(!left)
+      return false;
+    Type chunk[CHUNK_SIZE];
+    size_type count = read(chunk, CHUNK_SIZE);
+    for(size_type i = 0; i < count; ++i)
+      collection.append(chunk[i]);
+    return true;
+  }
+
+private:
+  int fd;
+  size_type total;
+  size_type left;
+};
+
+// Header and the whole buffer go out in one writev.
+template <typename Type, std::size_t Alignment, typename Stats>
+void serialize(int fd, const Vector<Type, Alignment, Stats>& vector) {
+  static_assert(std::is_trivially_copyable<Type>::value,
+                "Only trivially copyable types can be serialized");
+  static_assert(!std::is_same<Type, bool>::value, "The packed Vector<bool> has no bool buffer to serialize");
+  detail::StreamHeader header = detail::makeStreamHeader(sizeof(Type), vector.getSize());
+  iovec parts[2];
+  parts[0].iov_base = &header;
+  parts[0].iov_len = sizeof(header);
+  parts[1].iov_base = const_cast<Type*>(vector.data());
+  parts[1].iov_len = vector.getSize() * sizeof(Type);
+  detail::writeAll(fd, parts, 2);
+}
+
+// Node payloads are gathered into batches of WRITEV_BATCH iovecs.
+template <typename Type, typename Stats>
+void serialize(int fd, const LinkedList<Type, Stats>& list) {
+  static_assert(std::is_trivially_copyable<Type>::value,
+                "Only trivially copyable types can be serialized");
+  detail::StreamHeader header = detail::makeStreamHeader(sizeof(Type), list.getSize());
+  iovec batch[detail::WRITEV_BATCH];
+  batch[0].iov_base = &header;
+  batch[0].iov_len = sizeof(header);
+  std::size_t used = 1;
+  for(auto it = list.cbegin(); it != list.cend(); ++it) {
+    batch[used].iov_base = const_cast<Type*>(&*it);
+    batch[used].iov_len = sizeof(Type);
+    if(++used == detail::WRITEV_BATCH) {
+      detail::writeAll(fd, batch, used);
+      used = 0;
+    }
+  }
+  detail::writeAll(fd, batch, used);
+}
+
+// Replaces the contents of vector, reading straight into its buffer. A count
+// a Vector cannot hold, or one a regular file is too short for, is rejected
+// before anything is reserved; for other streams storage grows as the data
+// arrives, so a forged header cannot make it reserve more than was sent. If
+// the stream fails midway the vector is left empty.
+template <typename Type, std::size_t Alignment, typename Stats>
+void deserialize(int fd, Vector<Type, Alignment, Stats>& vector) {
+  StreamReader<Type> reader(fd);
+  std::size_t total = reader.getSize();
+  if(total >= static_cast<std::size_t>(INT_MAX))
+    throw std::runtime_error("Stream holds more elements than a Vector can");
+  off_t known = detail::bytesLeft(fd);
+  if(known >= 0 && static_cast<std::uint64_t>(known) < total * sizeof(Type))
+    throw std::runtime_error("Stream ended before all elements were read");
+  if(!vector.isEmpty())
+    vector.erase(vector.cbegin(), vector.cend());
+  try {
+    if(known >= 0)
+      vector.reserve(total);
+    while(reader.remaining()) {
+      if(vector.spare().isEmpty()) {
+        const std::size_t chunk = StreamReader<Type>::CHUNK_SIZE;
+        std::size_t size = vector.getSize();
+        std::size_t step = size > chunk ? size : chunk;
+        vector.reserve(step < total - size ? size + step : total);
+      }
+      Span<Type> spare = vector.spare();
+      vector.appendSpare(reader.read(spare.data(), spare.getSize()));
+    }
+  }
+  catch(...) {
+    if(!vector.isEmpty())
+      vector.erase(vector.cbegin(), vector.cend());
+    throw;
+  }
+}
+
+template <typename Type, typename Stats>
+void deserialize(int fd, LinkedList<Type, Stats>& list) {
+  StreamReader<Type> reader(fd);
+  if(!list.isEmpty())
+    list.erase(list.cbegin(), list.cend());
+  while(reader.readChunk(list))
+    ;
+}
+
+}
+
+#endif // AISDI_LINEAR_SERIALIZATION_H
@@ -0,0 +1,416 @@
+#ifndef AISDI_LINEAR_SIMDKERNELS_H
+#define AISDI_LINEAR_SIMDKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#  define AISDI_SIMD_X86 1
+#  include <immintrin.h>
+#endif
+
+namespace aisdi
+{
+namespace detail
+{
+
+// Linear search and reductions over a contiguous buffer.
+// find returns the index of the first match or count when there is none,
+// min/max/sum expect count > 0 (sum also copes with 0).
+template <typename Type>
+struct ScalarKernels {
+  static std::size_t find(const Type* data, std::size_t count, const Type& item) {
+    std::size_t i = 0;
+    for(; i < count; ++i)
+      if(data[i] == item)
+        break;
+    return i;
+  }
+
+  static std::size_t count(const Type* data, std::size_t count, const Type& item) {
+    std::size_t found = 0;
+    for(std::size_t i = 0; i < count; ++i)
+      if(data[i] == item)
+        ++found;
+    return found;
+  }
+
+  static Type min(const Type* data, std::size_t count) {
+    Type best = data[0];
+    for(std::size_t i = 1; i < count; ++i)
+      if(data[i] < best)
+        best = data[i];
+    return best;
+  }
+
+  static Type max(const Type* data, std::size_t count) {
+    Type best = data[0];
+    for(std::size_t i = 1; i < count; ++i)
+      if(best < data[i])
+        best = data[i];
+    return best;
+  }
+
+  static Type sum(const Type* data, std::size_t count) {
+    Type result = Type();
+    for(std::size_t i = 0; i < count; ++i)
+      result += data[i];
+    return result;
+  }
+};
+
+template <typename Type>
+struct SearchKernels {
+  std::size_t (*find)(const Type*, std::size_t, const Type&);
+  std::size_t (*count)(const Type*, std::size_t, const Type&);
+  Type (*min)(const Type*, std::size_t);
+  Type (*max)(const Type*, std::size_t);
+  Type (*sum)(const Type*, std::size_t);
+};
+
+template <typename Kernels, typename Type>
+SearchKernels<Type> makeSearchKernels() {
+  SearchKernels<Type> table = { &Kernels::find, &Kernels::count, &Kernels::min,
+                                &Kernels::max, &Kernels::sum };
+  return table;
+}
+
+#ifdef AISDI_SIMD_X86
+
+// GCC 12's AVX-512 headers trip -Wmaybe-uninitialized through _mm512_undefined_*.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#define AISDI_SSE4 __attribute__((target("sse4.2"), always_inline))
+#define AISDI_AVX2 __attribute__((target("avx2"), always_inline))
+#define AISDI_AVX512 __attribute__((target("avx512f"), always_inline))
+
+// Lane traits: one register type and its handful of operations per ISA/element type.
+// equalMask returns one bit per lane, lowest lane in the lowest bit.
+
+struct Sse4Int32 {
+  using value_type = std::int32_t;
+  using reg = __m128i;
+  static constexpr std::size_t lanes = 4;
+  AISDI_SSE4 static reg load(const value_type* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+  AISDI_SSE4 static void store(value_type* p, reg r) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), r); }
+  AISDI_SSE4 static reg broadcast(value_type v) { return _mm_set1_epi32(v); }
+  AISDI_SSE4 static unsigned equalMask(reg a, reg b) { return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))); }
+  AISDI_SSE4 static reg min(reg a, reg b) { return _mm_min_epi32(a, b); }
+  AISDI_SSE4 static reg max(reg a, reg b) { return _mm_max_epi32(a, b); }
+  AISDI_SSE4 static reg add(reg a, reg b) { return _mm_add_epi32(a, b); }
+};
+
+struct Sse4Uint64 {
+  using value_type = std::uint64_t;
+  using reg = __m128i;
+  static constexpr std::size_t lanes = 2;
+  AISDI_SSE4 static reg load(const value_type* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+  AISDI_SSE4 static void store(value_type* p, reg r) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), r); }
+  AISDI_SSE4 static reg broadcast(value_type v) { return _mm_set1_epi64x(static_cast<long long>(v)); }
+  AISDI_SSE4 static unsigned equalMask(reg a, reg b) { return _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(a, b))); }
+  AISDI_SSE4 static reg greater(reg a, reg b) { // unsigned a > b via flipped sign bits
+    const reg sign = _mm_set1_epi64x(static_cast<long long>(0x8000000000000000ULL));
+    return _mm_cmpgt_epi64(_mm_xor_si128(a, sign), _mm_xor_si128(b, sign));
+  }
+  AISDI_SSE4 static reg min(reg a, reg b) { return _mm_blendv_epi8(a, b, greater(a, b)); }
+  AISDI_SSE4 static reg max(reg a, reg b) { return _mm_blendv_epi8(b, a, greater(a, b)); }
+  AISDI_SSE4 static reg add(reg a, reg b) { return _mm_add_epi64(a, b); }
+};
+
+struct Sse4Float {
+  using value_type = float;
+  using reg = __m128;
+  static constexpr std::size_t lanes = 4;
+  AISDI_SSE4 static reg load(const value_type* p) { return _mm_loadu_ps(p); }
+  AISDI_SSE4 static void store(value_type* p, reg r) { _mm_storeu_ps(p, r); }
+  AISDI_SSE4 static reg broadcast(value_type v) { return _mm_set1_ps(v); }
+  AISDI_SSE4 static unsigned equalMask(reg a, reg b) { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+  AISDI_SSE4 static reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+  AISDI_SSE4 static reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+  AISDI_SSE4 static reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+};
+
+struct Sse4Double {
+  using value_type = double;
+  using reg = __m128d;
+  static constexpr std::size_t lanes = 2;
+  AISDI_SSE4 static reg load(const value_type* p) { return _mm_loadu_pd(p); }
+  AISDI_SSE4 static void store(value_type* p, reg r) { _mm_storeu_pd(p, r); }
+  AISDI_SSE4 static reg broadcast(value_type v) { return _mm_set1_pd(v); }
+  AISDI_SSE4 static unsigned equalMask(reg a, reg b) { return _mm_movemask_pd(_mm_cmpeq_pd(a, b)); }
+  AISDI_SSE4 static reg min(reg a, reg b) { return _mm_min_pd(a, b); }
+  AISDI_SSE4 static reg max(reg a, reg b) { return _mm_max_pd(a, b); }
+  AISDI_SSE4 static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+};
+
+struct Avx2Int32 {
+  using value_type = std::int32_t;
+  using reg = __m256i;
+  static constexpr std::size_t lanes = 8;
+  AISDI_AVX2 static reg load(const value_type* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+  AISDI_AVX2 static void store(value_type* p, reg r) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), r); }
+  AISDI_AVX2 static reg broadcast(value_type v) { return _mm256_set1_epi32(v); }
+  AISDI_AVX2 static unsigned equalMask(reg a, reg b) { return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))); }
+  AISDI_AVX2 static reg min(reg a, reg b) { return _mm256_min_epi32(a, b); }
+  AISDI_AVX2 static reg max(reg a, reg b) { return _mm256_max_epi32(a, b); }
+  AISDI_AVX2 static reg add(reg a, reg b) { return _mm256_add_epi32(a, b); }
+};
+
+struct Avx2Uint64 {
+  using value_type = std::uint64_t;
+  using reg = __m256i;
+  static constexpr std::size_t lanes = 4;
+  AISDI_AVX2 static reg load(const value_type* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+  AISDI_AVX2 static void store(value_type* p, reg r) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), r); }
+  AISDI_AVX2 static reg broadcast(value_type v) { return _mm256_set1_epi64x(static_cast<long long>(v)); }
+  AISDI_AVX2 static unsigned equalMask(reg a, reg b) { return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b))); }
+  AISDI_AVX2 static reg greater(reg a, reg b) {
+    const reg sign = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ULL));
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(a, sign), _mm256_xor_si256(b, sign));
+  }
+  AISDI_AVX2 static reg min(reg a, reg b) { return _mm256_blendv_epi8(a, b, greater(a, b)); }
+  AISDI_AVX2 static reg max(reg a, reg b) { return _mm256_blendv_epi8(b, a, greater(a, b)); }
+  AISDI_AVX2 static reg add(reg a, reg b) { return _mm256_add_epi64(a, b); }
+};
+
+struct Avx2Float {
+  using value_type = float;
+  using reg = __m256;
+  static constexpr std::size_t lanes = 8;
+  AISDI_AVX2 static reg load(const value_type* p) { return _mm256_loadu_ps(p); }
+  AISDI_AVX2 static void store(value_type* p, reg r) { _mm256_storeu_ps(p, r); }
+  AISDI_AVX2 static reg broadcast(value_type v) { return _mm256_set1_ps(v); }
+  AISDI_AVX2 static unsigned equalMask(reg a, reg b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+  AISDI_AVX2 static reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+  AISDI_AVX2 static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+  AISDI_AVX2 static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+};
+
+struct Avx2Double {
+  using value_type = double;
+  using reg = __m256d;
+  static constexpr std::size_t lanes = 4;
+  AISDI_AVX2 static reg load(const value_type* p) { return _mm256_loadu_pd(p); }
+  AISDI_AVX2 static void store(value_type* p, reg r) { _mm256_storeu_pd(p, r); }
+  AISDI_AVX2 static reg broadcast(value_type v) { return _mm256_set1_pd(v); }
+  AISDI_AVX2 static unsigned equalMask(reg a, reg b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+  AISDI_AVX2 static reg min(reg a, reg b) { return _mm256_min_pd(a, b); }
+  AISDI_AVX2 static reg max(reg a, reg b) { return _mm256_max_pd(a, b); }
+  AISDI_AVX2 static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+};
+
+struct Avx512Int32 {
+  using value_type = std::int32_t;
+  using reg = __m512i;
+  static constexpr std::size_t lanes = 16;
+  AISDI_AVX512 static reg load(const value_type* p) { return _mm512_loadu_si512(p); }
+  AISDI_AVX512 static void store(value_type* p, reg r) { _mm512_storeu_si512(p, r); }
+  AISDI_AVX512 static reg broadcast(value_type v) { return _mm512_set1_epi32(v); }
+  AISDI_AVX512 static unsigned equalMask(reg a, reg b) { return _mm512_cmpeq_epi32_mask(a, b); }
+  AISDI_AVX512 static reg min(reg a, reg b) { return _mm512_min_epi32(a, b); }
+  AISDI_AVX512 static reg max(reg a, reg b) { return _mm512_max_epi32(a, b); }
+  AISDI_AVX512 static reg add(reg a, reg b) { return _mm512_add_epi32(a, b); }
+};
+
+struct Avx512Uint64 {
+  using value_type = std::uint64_t;
+  using reg = __m512i;
+  static constexpr std::size_t lanes = 8;
+  AISDI_AVX512 static reg load(const value_type* p) { return _mm512_loadu_si512(p); }
+  AISDI_AVX512 static void store(value_type* p, reg r) { _mm512_storeu_si512(p, r); }
+  AISDI_AVX512 static reg broadcast(value_type v) { return _mm512_set1_epi64(static_cast<long long>(v)); }
+  AISDI_AVX512 static unsigned equalMask(reg a, reg b) { return _mm512_cmpeq_epu64_mask(a, b); }
+  AISDI_AVX512 static reg min(reg a, reg b) { return _mm512_min_epu64(a, b); }
+  AISDI_AVX512 static reg max(reg a, reg b) { return _mm512_max_epu64(a, b); }
+  AISDI_AVX512 static reg add(reg a, reg b) { return _mm512_add_epi64(a, b); }
+};
+
+struct Avx512Float {
+  using value_type = float;
+  using reg = __m512;
+  static constexpr std::size_t lanes = 16;
+  AISDI_AVX512 static reg load(const value_type* p) { return _mm512_loadu_ps(p); }
+  AISDI_AVX512 static void store(value_type* p, reg r) { _mm512_storeu_ps(p, r); }
+  AISDI_AVX512 static reg broadcast(value_type v) { return _mm512_set1_ps(v); }
+  AISDI_AVX512 static unsigned equalMask(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+  AISDI_AVX512 static reg min(reg a, reg b) { return _mm512_min_ps(a, b); }
+  AISDI_AVX512 static reg max(reg a, reg b) { return _mm512_max_ps(a, b); }
+  AISDI_AVX512 static reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+};
+
+struct Avx512Double {
+  using value_type = double;
+  using reg = __m512d;
+  static constexpr std::size_t lanes = 8;
+  AISDI_AVX512 static reg load(const value_type* p) { return _mm512_loadu_pd(p); }
+  AISDI_AVX512 static void store(value_type* p, reg r) { _mm512_storeu_pd(p, r); }
+  AISDI_AVX512 static reg broadcast(value_type v) { return _mm512_set1_pd(v); }
+  AISDI_AVX512 static unsigned equalMask(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+  AISDI_AVX512 static reg min(reg a, reg b) { return _mm512_min_pd(a, b); }
+  AISDI_AVX512 static reg max(reg a, reg b) { return _mm512_max_pd(a, b); }
+  AISDI_AVX512 static reg add(reg a, reg b) { return _mm512_add_pd(a, b); }
+};
+
+// The same kernel bodies compiled once per ISA; GCC refuses to inline lane
+// operations into a function without the matching target, hence the macro.
+// Floating point sums are reassociated, min/max are unspecified with NaNs.
+#define AISDI_DEFINE_SIMD_KERNELS(Name, Target)                                      \
+template <typename Lanes>                                                            \
+struct Name {                                                                        \
+  using Type = typename Lanes::value_type;                                           \
+  using reg = typename Lanes::reg;                                                   \
+  static constexpr std::size_t lanes = Lanes::lanes;                                 \
+                                                                                     \
+  __attribute__((target(Target)))                                                    \
+  static std::size_t find(const Type* data, std::size_t count, const Type& item) {   \
+    const reg needle = Lanes::broadcast(item);                                       \
+    std::size_t i = 0;                                                               \
+    for(; i + lanes <= count; i += lanes) {                                          \
+      const unsigned mask = Lanes::equalMask(Lanes::load(data + i), needle);         \
+      if(mask)                                                                       \
+        return i + __builtin_ctz(mask);                                              \
+    }                                                                                \
+    return i + ScalarKernels<Type>::find(data + i, count - i, item);                 \
+  }                                                                                  \
+                                                                                     \
+  __attribute__((target(Target)))                                                    \
+  static std::size_t count(const Type* data, std::size_t count, const Type& item) {  \
+    const reg needle = Lanes::broadcast(item);                                       \
+    std::size_t found = 0;                                                           \
+    std::size_t i = 0;                                                               \
+    for(; i + lanes <= count; i += lanes)                                            \
+      found += __builtin_popcount(Lanes::equalMask(Lanes::load(data + i), needle));  \
+    return found + ScalarKernels<Type>::count(data + i, count - i, item);            \
+  }                                                                                  \
+                                                                                     \
+  __attribute__((target(Target)))                                                    \
+  static Type min(const Type* data, std::size_t count) {                             \
+    if(count < lanes)                                                                \
+      return ScalarKernels<Type>::min(data, count);                                  \
+    reg best = Lanes::load(data);                                                    \
+    std::size_t i = lanes;                                                           \
+    for(; i + lanes <= count; i += lanes)                                            \
+      best = Lanes::min(best, Lanes::load(data + i));                                \
+    Type spill[lanes];                                                               \
+    Lanes::store(spill, best);                                                       \
+    Type result = ScalarKernels<Type>::min(spill, lanes);                            \
+    for(; i < count; ++i)                                                            \
+      if(data[i] < result)                                                           \
+        result = data[i];                                                            \
+    return result;                                                                   \
+  }                                                                                  \
+                                                                                     \
+  __attribute__((target(Target)))                                                    \
+  static Type max(const Type* data, std::size_t count) {                             \
+    if(count < lanes)                                                                \
+      return ScalarKernels<Type>::max(data, count);                                  \
+    reg best = Lanes::load(data);                                                    \
+    std::size_t i = lanes;                                                           \
+    for(; i + lanes <= count; i += lanes)                                            \
+      best = Lanes::max(best, Lanes::load(data + i));                                \
+    Type spill[lanes];                                                               \
+    Lanes::store(spill, best);                                                       \
+    Type result = ScalarKernels<Type>::max(spill, lanes);                            \
+    for(; i < count; ++i)                                                            \
+      if(result < data[i])                                                           \
+        result = data[i];                                                            \
+    return result;                                                                   \
+  }                                                                                  \
+                                                                                     \
+  __attribute__((target(Target)))                                                    \
+  static Type sum(const Type* data, std::size_t count) {                             \
+    reg total = Lanes::broadcast(Type());                                            \
+    std::size_t i = 0;                                                               \
+    for(; i + lanes <= count; i += lanes)                                            \
+      total = Lanes::add(total, Lanes::load(data + i));                              \
+    Type spill[lanes];                                                               \
+    Lanes::store(spill, total);                                                      \
+    return ScalarKernels<Type>::sum(spill, lanes)                                    \
+           + ScalarKernels<Type>::sum(data + i, count - i);                          \
+  }                                                                                  \
+};
+
+AISDI_DEFINE_SIMD_KERNELS(Sse4Kernels, "sse4.2")
+AISDI_DEFINE_SIMD_KERNELS(Avx2Kernels, "avx2")
+AISDI_DEFINE_SIMD_KERNELS(Avx512Kernels, "avx512f")
+
+#undef AISDI_DEFINE_SIMD_KERNELS
+#undef AISDI_SSE4
+#undef AISDI_AVX2
+#undef AISDI_AVX512
+
+#pragma GCC diagnostic pop
+
+template <typename Type, typename Sse4, typename Avx2, typename Avx512>
+SearchKernels<Type> selectSearchKernels() {
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx512f"))
+    return makeSearchKernels<Avx512Kernels<Avx512>, Type>();
+  if(__builtin_cpu_supports("avx2"))
+    return makeSearchKernels<Avx2Kernels<Avx2>, Type>();
+  if(__builtin_cpu_supports("sse4.2"))
+    return makeSearchKernels<Sse4Kernels<Sse4>, Type>();
+  return makeSearchKernels<ScalarKernels<Type>, Type>();
+}
+
+#endif // AISDI_SIMD_X86
+
+// Generic element types go straight to the scalar loops, so min/max are only
+// instantiated (and only need operator<) when they are actually called.
+template <typename Type>
+struct SearchDispatch : ScalarKernels<Type> {};
+
+#ifdef AISDI_SIMD_X86
+
+// Picks the widest kernel set the CPU supports, once per element type.
+template <typename Type, typename Sse4, typename Avx2, typename Avx512>
+struct SimdSearchDispatch {
+  static const SearchKernels<Type>& kernels() {
+    static const SearchKernels<Type> table = selectSearchKernels<Type, Sse4, Avx2, Avx512>();
+    return table;
+  }
+
+  static std::size_t find(const Type* data, std::size_t count, const Type& item) {
+    return kernels().find(data, count, item);
+  }
+
+  static std::size_t count(const Type* data, std::size_t count, const Type& item) {
+    return kernels().count(data, count, item);
+  }
+
+  static Type min(const Type* data, std::size_t count) {
+    return kernels().min(data, count);
+  }
+
+  static Type max(const Type* data, std::size_t count) {
+    return kernels().max(data, count);
+  }
+
+  static Type sum(const Type* data, std::size_t count) {
+    return kernels().sum(data, count);
+  }
+};
+
+template <>
+struct SearchDispatch<std::int32_t>
+  : SimdSearchDispatch<std::int32_t, Sse4Int32, Avx2Int32, Avx512Int32> {};
+
+template <>
+struct SearchDispatch<std::uint64_t>
+  : SimdSearchDispatch<std::uint64_t, Sse4Uint64, Avx2Uint64, Avx512Uint64> {};
+
+template <>
+struct SearchDispatch<float>
+  : SimdSearchDispatch<float, Sse4Float, Avx2Float, Avx512Float> {};
+
+template <>
+struct SearchDispatch<double>
+  : SimdSearchDispatch<double, Sse4Double, Avx2Double, Avx512Double> {};
+
+#endif // AISDI_SIMD_X86
+
+}
+}
+
+#endif // AISDI_LINEAR_SIMDKERNELS_H
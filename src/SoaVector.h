@@ -0,0 +1,337 @@
+#ifndef AISDI_LINEAR_SOAVECTOR_H
+#define AISDI_LINEAR_SOAVECTOR_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Span.h"
+#include "Vector.h"
+
+namespace aisdi
+{
+
+// Struct-of-arrays vector: each of Fields... lives in its own Vector, so a
+// scan over one field only streams that column through the cache. Rows are
+// read and written as tuples; column<I>() hands out a Span for tight loops.
+// bool fields are stored a byte each (UnpackedVector), so rows can hold
+// bool&; they have no column() Span.
+template <typename... Fields>
+class SoaVector
+{
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = std::tuple<Fields...>;
+  using reference = std::tuple<Fields&...>;
+  using const_reference = std::tuple<const Fields&...>;
+
+  template <std::size_t I>
+  using field_type = typename std::tuple_element<I, value_type>::type;
+
+  class ConstIterator;
+  class Iterator;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  static const std::size_t FIELD_COUNT = sizeof...(Fields);
+
+  SoaVector() : size(0) {}
+
+  bool isEmpty() const {
+    return !size;
+  }
+
+  size_type getSize() const {
+    return size;
+  }
+
+  void reserve(size_type newCapacity) {
+    forEachColumn(Reserve{ newCapacity });
+  }
+
+  void append(const Fields&... values) {
+    appendRow(std::forward_as_tuple(values...), Indices());
+    ++size;
+  }
+
+  void append(const value_type& row) {
+    appendRow(row, Indices());
+    ++size;
+  }
+
+  value_type popLast() {
+    if(isEmpty())
+      throw std::logic_error("Attempt to pop last in empty vector");
+    --size;
+    return popLastRow(Indices());
+  }
+
+  void erase(size_type index) {
+    if(index >= size)
+      throw std::out_of_range("attempt to erase at end iterator");
+    forEachColumn(Erase{ index });
+    --size;
+  }
+
+  void erase(const const_iterator& position) {
+    erase(position.index);
+  }
+
+  reference at(size_type index) {
+    checkIndex(index);
+    return rowAt(index, Indices());
+  }
+
+  const_reference at(size_type index) const {
+    checkIndex(index);
+    return rowAt(index, Indices());
+  }
+
+  template <std::size_t I>
+  field_type<I>& get(size_type index) {
+    checkIndex(index);
+    return detail::unpacked(std::get<I>(columns).data()[index]);
+  }
+
+  template <std::size_t I>
+  const field_type<I>& get(size_type index) const {
+    checkIndex(index);
+    return detail::unpacked(std::get<I>(columns).data()[index]);
+  }
+
+  template <std::size_t I>
+  Span<field_type<I>> column() {
+    static_assert(!std::is_same<field_type<I>, bool>::value, "bool columns have no Span, use get<I>()");
+    return Span<field_type<I>>(std::get<I>(columns).data(), size);
+  }
+
+  template <std::size_t I>
+  Span<const field_type<I>> column() const {
+    static_assert(!std::is_same<field_type<I>, bool>::value, "bool columns have no Span, use get<I>()");
+    return Span<const field_type<I>>(std::get<I>(columns).data(), size);
+  }
+
+  iterator begin() {
+    return iterator(0, this);
+  }
+
+  iterator end() {
+    return iterator(size, this);
+  }
+
+  const_iterator cbegin() const {
+    return const_iterator(0, this);
+  }
+
+  const_iterator cend() const {
+    return const_iterator(size, this);
+  }
+
+  const_iterator begin() const {
+    return cbegin();
+  }
+
+  const_iterator end() const {
+    return cend();
+  }
+
+private:
+  using Indices = std::index_sequence_for<Fields...>;
+
+  struct Reserve {
+    size_type capacity;
+    template <typename Column>
+    void operator()(Column& column) const {
+      column.reserve(capacity);
+    }
+  };
+
+  struct Erase {
+    size_type index;
+    template <typename Column>
+    void operator()(Column& column) const {
+      column.erase(column.cbegin() + index);
+    }
+  };
+
+  template <typename Operation>
+  void forEachColumn(const Operation& operation) {
+    forEachColumn(operation, Indices());
+  }
+
+  template <typename Operation, std::size_t... I>
+  void forEachColumn(const Operation& operation, std::index_sequence<I...>) {
+    int expand[] = { 0, (operation(std::get<I>(columns)), 0)... };
+    (void)expand;
+  }
+
+  // If a column throws, the columns already appended to drop their new
+  // element again, so all columns keep the same length.
+  template <typename Row, std::size_t... I>
+  void appendRow(const Row& row, std::index_sequence<I...>) {
+    std::size_t appended = 0;
+    try {
+      int expand[] = { 0, (std::get<I>(columns).append(std::get<I>(row)), ++appended, 0)... };
+      (void)expand;
+    }
+    catch(...) {
+      int expand[] = { 0, (I < appended ? (dropLast(std::get<I>(columns)), 0) : 0)... };
+      (void)expand;
+      throw;
+    }
+  }
+
+  template <typename Column>
+  static void dropLast(Column& column) { // erasing at the end copies nothing
+    column.erase(column.cend() - 1, column.cend());
+  }
+
+  template <std::size_t... I>
+  value_type popLastRow(std::index_sequence<I...>) {
+    return value_type(std::get<I>(columns).popLast()...);
+  }
+
+  template <std::size_t... I>
+  reference rowAt(size_type index, std::index_sequence<I...>) {
+    return reference(detail::unpacked(std::get<I>(columns).data()[index])...);
+  }
+
+  template <std::size_t... I>
+  const_reference rowAt(size_type index, std::index_sequence<I...>) const {
+    return const_reference(detail::unpacked(std::get<I>(columns).data()[index])...);
+  }
+
+  void checkIndex(size_type index) const {
+    if(index >= size)
+      throw std::out_of_range("Attempt to access out of vector range");
+  }
+
+  std::tuple<UnpackedVector<Fields>...> columns;
+  size_type size;
+};
+
+// Proxy iterators: dereferencing yields a tuple of references into the columns.
+template <typename... Fields>
+class SoaVector<Fields...>::ConstIterator
+{
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename SoaVector::value_type;
+  using difference_type = typename SoaVector::difference_type;
+  using reference = typename SoaVector::const_reference;
+  using pointer = void;
+
+  explicit ConstIterator(size_type i = 0, const SoaVector* v = nullptr) : index(i), vec(v) {}
+
+  reference operator*() const {
+    if(index >= vec->size)
+      throw std::out_of_range("Attempt to dereference end iterator");
+    return vec->rowAt(index, Indices());
+  }
+
+  ConstIterator& operator++() {
+    if(index == vec->size)
+      throw std::out_of_range("Attempt to increment end iterator");
+    ++index;
+    return *this;
+  }
+
+  ConstIterator operator++(int) {
+    ConstIterator result = *this;
+    operator++();
+    return result;
+  }
+
+  ConstIterator& operator--() {
+    if(index == 0)
+      throw std::out_of_range("Attempt to decrement begin iterator");
+    --index;
+    return *this;
+  }
+
+  ConstIterator operator--(int) {
+    ConstIterator result = *this;
+    operator--();
+    return result;
+  }
+
+  ConstIterator operator+(difference_type d) const {
+    if(index + d > vec->size)
+      throw std::out_of_range("Attempt to add out of vector range");
+    return ConstIterator(index + d, vec);
+  }
+
+  ConstIterator operator-(difference_type d) const {
+    if(d > static_cast<difference_type>(index))
+      throw std::out_of_range("Attempt to substract out of vector range");
+    return ConstIterator(index - d, vec);
+  }
+
+  bool operator==(const ConstIterator& other) const {
+    return vec == other.vec && index == other.index;
+  }
+
+  bool operator!=(const ConstIterator& other) const {
+    return !operator==(other);
+  }
+
+protected:
+  size_type index;
+  const SoaVector* vec;
+
+  friend class SoaVector;
+};
+
+template <typename... Fields>
+class SoaVector<Fields...>::Iterator : public SoaVector<Fields...>::ConstIterator
+{
+public:
+  using reference = typename SoaVector::reference;
+
+  explicit Iterator(size_type i, const SoaVector* v) : ConstIterator(i, v) {}
+
+  Iterator(const ConstIterator& other)
+    : ConstIterator(other) {}
+
+  Iterator& operator++() {
+    ConstIterator::operator++();
+    return *this;
+  }
+
+  Iterator operator++(int) {
+    auto result = *this;
+    ConstIterator::operator++();
+    return result;
+  }
+
+  Iterator& operator--() {
+    ConstIterator::operator--();
+    return *this;
+  }
+
+  Iterator operator--(int) {
+    auto result = *this;
+    ConstIterator::operator--();
+    return result;
+  }
+
+  Iterator operator+(difference_type d) const {
+    return ConstIterator::operator+(d);
+  }
+
+  Iterator operator-(difference_type d) const {
+    return ConstIterator::operator-(d);
+  }
+
+  reference operator*() const {
+    ConstIterator::operator*(); // bounds check
+    return const_cast<SoaVector*>(this->vec)->rowAt(this->index, Indices());
+  }
+};
+
+}
+
+#endif // AISDI_LINEAR_SOAVECTOR_H
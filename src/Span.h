@@ -0,0 +1,73 @@
+#ifndef AISDI_LINEAR_SPAN_H
+#define AISDI_LINEAR_SPAN_H
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace aisdi
+{
+
+// Non-owning view of count contiguous elements; valid as long as the
+// container it was taken from is not resized.
+template <typename Type>
+class Span
+{
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = Type;
+  using pointer = Type*;
+  using reference = Type&;
+  using iterator = Type*;
+
+  Span() : first(nullptr), count(0) {}
+
+  Span(Type* data, size_type size) : first(data), count(size) {}
+
+  template <typename Other> // Span<T> -> Span<const T>
+  Span(const Span<Other>& other) : first(other.data()), count(other.getSize()) {}
+
+  bool isEmpty() const {
+    return !count;
+  }
+
+  size_type getSize() const {
+    return count;
+  }
+
+  pointer data() const {
+    return first;
+  }
+
+  reference operator[](size_type index) const { // unchecked, for hot loops
+    return first[index];
+  }
+
+  reference at(size_type index) const {
+    if(index >= count)
+      throw std::out_of_range("Attempt to access out of span range");
+    return first[index];
+  }
+
+  Span subspan(size_type offset, size_type length) const {
+    if(offset > count || length > count - offset)
+      throw std::out_of_range("Attempt to take subspan out of span range");
+    return Span(first + offset, length);
+  }
+
+  iterator begin() const {
+    return first;
+  }
+
+  iterator end() const {
+    return first + count;
+  }
+
+private:
+  Type* first;
+  size_type count;
+};
+
+}
+
+#endif // AISDI_LINEAR_SPAN_H
@@ -0,0 +1,306 @@
+#ifndef AISDI_LINEAR_TOMBSTONEVECTOR_H
+#define AISDI_LINEAR_TOMBSTONEVECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "Vector.h"
+
+namespace aisdi
+{
+
+// Vector with lazy erase: erasing clears the element's flag in a packed
+// Vector<bool> of live slots instead of shifting the tail, and iteration
+// skips dead slots a word at a time. Once more than compactPercent of the
+// slots are dead, or on compact(), the survivors are moved down in a single
+// pass, so erasing k elements one by one costs O(n + k) instead of O(n k).
+// Compaction invalidates iterators; erase returns a valid one to continue.
+// Elements are kept in an UnpackedVector, so bool elements are a byte each.
+template <typename Type>
+class TombstoneVector
+{
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = Type;
+  using pointer = Type*;
+  using reference = Type&;
+  using const_pointer = const Type*;
+  using const_reference = const Type&;
+
+  class ConstIterator;
+  class Iterator;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  static const size_type DEFAULT_COMPACT_PERCENT = 25;
+
+  explicit TombstoneVector(size_type compactPercent = DEFAULT_COMPACT_PERCENT)
+    : dead(0), threshold(compactPercent) {
+    if(compactPercent > 100)
+      throw std::out_of_range("Compaction threshold must be a percentage");
+  }
+
+  TombstoneVector(std::initializer_list<Type> l) : TombstoneVector() {
+    for(auto it = l.begin(); it != l.end(); ++it)
+      append(*it);
+  }
+
+  bool isEmpty() const {
+    return !getSize();
+  }
+
+  size_type getSize() const { // live elements
+    return items.getSize() - dead;
+  }
+
+  size_type getDeadCount() const {
+    return dead;
+  }
+
+  size_type getSlotCount() const { // live and dead
+    return items.getSize();
+  }
+
+  void append(const Type& item) {
+    items.append(item);
+    live.append(true);
+  }
+
+  Type popLast() {
+    if(isEmpty())
+      throw std::logic_error("Attempt to pop last in empty vector");
+    while(!isLive(items.getSize() - 1)) {
+      items.popLast();
+      live.popLast();
+      --dead;
+    }
+    live.popLast();
+    return items.popLast();
+  }
+
+  Type popFirst() {
+    if(isEmpty())
+      throw std::logic_error("Attempt to pop first in empty vector");
+    size_type first = live.findFirst();
+    Type item = detail::unpacked(items.data()[first]);
+    kill(first);
+    compactIfSparse(first);
+    return item;
+  }
+
+  // Marks the element dead; returns an iterator to the element after it.
+  iterator erase(const const_iterator& position) {
+    if(position.slot >= items.getSize())
+      throw std::out_of_range("attempt to erase at end iterator");
+    kill(position.slot);
+    return iterator(const_iterator(this, compactIfSparse(live.findNext(position.slot))));
+  }
+
+  iterator erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded) {
+    for(size_type slot = firstIncluded.slot; slot < lastExcluded.slot; slot = live.findNext(slot))
+      kill(slot);
+    return iterator(const_iterator(this, compactIfSparse(lastExcluded.slot)));
+  }
+
+  // Marks every live element matching pred dead, then compacts once.
+  template <typename Predicate>
+  size_type removeIf(Predicate pred) {
+    size_type removed = 0;
+    for(size_type slot = live.findFirst(); slot < items.getSize(); slot = live.findNext(slot))
+      if(pred(static_cast<const Type&>(detail::unpacked(items.data()[slot])))) {
+        kill(slot);
+        ++removed;
+      }
+    compact();
+    return removed;
+  }
+
+  // Moves the live elements down over the dead ones in one pass.
+  void compact() {
+    compactTracking(items.getSize());
+  }
+
+  iterator begin() {
+    return iterator(cbegin());
+  }
+
+  iterator end() {
+    return iterator(cend());
+  }
+
+  const_iterator cbegin() const {
+    return const_iterator(this, live.findFirst());
+  }
+
+  const_iterator cend() const {
+    return const_iterator(this, items.getSize());
+  }
+
+  const_iterator begin() const {
+    return cbegin();
+  }
+
+  const_iterator end() const {
+    return cend();
+  }
+
+private:
+  bool isLive(size_type slot) const {
+    return *(live.cbegin() + slot);
+  }
+
+  void kill(size_type slot) {
+    if(!isLive(slot))
+      throw std::logic_error("Attempt to erase dead element");
+    *(live.begin() + slot) = false;
+    ++dead;
+  }
+
+  // Compacts when too many slots are dead; returns where slot ended up.
+  size_type compactIfSparse(size_type slot) {
+    if(dead * 100 <= threshold * items.getSize())
+      return slot;
+    return compactTracking(slot);
+  }
+
+  size_type compactTracking(size_type slot) {
+    if(!dead)
+      return slot;
+    auto* data = items.data();
+    size_type kept = 0, moved = slot;
+    for(size_type from = live.findFirst(); from < items.getSize(); from = live.findNext(from)) {
+      if(from == slot)
+        moved = kept;
+      if(kept != from)
+        data[kept] = std::move(data[from]);
+      ++kept;
+    }
+    if(slot >= items.getSize())
+      moved = kept;
+    items.erase(items.cbegin() + kept, items.cend());
+    Vector<bool> flags;
+    flags.reserve(kept);
+    for(size_type i = 0; i < kept; ++i)
+      flags.append(true);
+    live = std::move(flags);
+    dead = 0;
+    return moved;
+  }
+
+  UnpackedVector<Type> items;
+  Vector<bool> live;
+  size_type dead;
+  size_type threshold; // percent of dead slots that triggers compaction
+};
+
+template <typename Type>
+class TombstoneVector<Type>::ConstIterator
+{
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename TombstoneVector::value_type;
+  using difference_type = typename TombstoneVector::difference_type;
+  using pointer = typename TombstoneVector::const_pointer;
+  using reference = typename TombstoneVector::const_reference;
+
+  ConstIterator() : vec(nullptr), slot(0) {}
+
+  ConstIterator(const TombstoneVector* v, size_type s) : vec(v), slot(s) {}
+
+  reference operator*() const {
+    if(slot >= vec->items.getSize())
+      throw std::out_of_range("Attempt to dereference end iterator");
+    return detail::unpacked(vec->items.data()[slot]);
+  }
+
+  ConstIterator& operator++() {
+    if(slot >= vec->items.getSize())
+      throw std::out_of_range("Attempt to increment end iterator");
+    slot = vec->live.findNext(slot);
+    return *this;
+  }
+
+  ConstIterator operator++(int) {
+    ConstIterator result = *this;
+    operator++();
+    return result;
+  }
+
+  ConstIterator& operator--() {
+    size_type previous = slot;
+    while(previous > 0 && !vec->isLive(previous - 1))
+      --previous;
+    if(previous == 0)
+      throw std::out_of_range("Attempt to decrement begin iterator");
+    slot = previous - 1;
+    return *this;
+  }
+
+  ConstIterator operator--(int) {
+    ConstIterator result = *this;
+    operator--();
+    return result;
+  }
+
+  bool operator==(const ConstIterator& other) const {
+    return vec == other.vec && slot == other.slot;
+  }
+
+  bool operator!=(const ConstIterator& other) const {
+    return !operator==(other);
+  }
+
+protected:
+  const TombstoneVector* vec;
+  size_type slot;
+
+  friend class TombstoneVector;
+};
+
+template <typename Type>
+class TombstoneVector<Type>::Iterator : public TombstoneVector<Type>::ConstIterator
+{
+public:
+  using pointer = typename TombstoneVector::pointer;
+  using reference = typename TombstoneVector::reference;
+
+  Iterator() {}
+
+  Iterator(const ConstIterator& other)
+    : ConstIterator(other) {}
+
+  Iterator& operator++() {
+    ConstIterator::operator++();
+    return *this;
+  }
+
+  Iterator operator++(int) {
+    auto result = *this;
+    ConstIterator::operator++();
+    return result;
+  }
+
+  Iterator& operator--() {
+    ConstIterator::operator--();
+    return *this;
+  }
+
+  Iterator operator--(int) {
+    auto result = *this;
+    ConstIterator::operator--();
+    return result;
+  }
+
+  reference operator*() const {
+    // ugly cast, yet reduces code duplication.
+    return const_cast<reference>(ConstIterator::operator*());
+  }
+};
+
+}
+
+#endif // AISDI_LINEAR_TOMBSTONEVECTOR_H
@@ -0,0 +1,328 @@
+#ifndef AISDI_LINEAR_TRACE_H
+#define AISDI_LINEAR_TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include <sys/uio.h>
+
+#include "Serialization.h"
+
+// Workload traces: Recording wraps a Vector or LinkedList and logs every
+// operation with its position to a file descriptor, so a production access
+// pattern can be replayed against other containers (see bench --mode replay).
+// Binary format: TraceHeader, then one record per operation until the end of
+// the stream: a TraceOp byte, followed for Insert and Erase by the position
+// and for Erase by the count, both as LEB128 varints. Element values are not
+// recorded; replay only needs the shape of the workload.
+
+namespace aisdi
+{
+
+enum class TraceOp : std::uint8_t {
+  Append,
+  Prepend,
+  Insert,   // position
+  PopFirst,
+  PopLast,
+  Erase,    // position, count
+  Iterate   // one full pass
+};
+
+struct TraceEvent {
+  TraceOp op;
+  std::uint64_t position;
+  std::uint64_t count;
+};
+
+namespace detail
+{
+
+struct TraceHeader {
+  char magic[4];
+  std::uint16_t version;
+  std::uint16_t reserved;
+};
+
+const std::uint16_t TRACE_VERSION = 1;
+const std::size_t TRACE_BUFFER_BYTES = 1 << 16;
+const std::size_t MAX_TRACE_RECORD_BYTES = 1 + 2 * 10; // op and two 64-bit varints
+
+}
+
+class TraceWriter
+{
+public:
+  explicit TraceWriter(int descriptor) : fd(descriptor), events(0) {
+    buffer.reserve(detail::TRACE_BUFFER_BYTES);
+    detail::TraceHeader header;
+    std::memcpy(header.magic, "AIST", 4);
+    header.version = detail::TRACE_VERSION;
+    header.reserved = 0;
+    const char* bytes = reinterpret_cast<const char*>(&header);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(header));
+  }
+
+  TraceWriter(const TraceWriter&) = delete;
+  TraceWriter& operator=(const TraceWriter&) = delete;
+
+  ~TraceWriter() {
+    try {
+      flush();
+    }
+    catch(...) {
+    }
+  }
+
+  std::uint64_t getEventCount() const {
+    return events;
+  }
+
+  void record(TraceOp op, std::uint64_t position = 0, std::uint64_t count = 0) {
+    if(buffer.size() + detail::MAX_TRACE_RECORD_BYTES > detail::TRACE_BUFFER_BYTES)
+      flush();
+    buffer.push_back(static_cast<std::uint8_t>(op));
+    if(op == TraceOp::Insert || op == TraceOp::Erase)
+      writeVarint(position);
+    if(op == TraceOp::Erase)
+      writeVarint(count);
+    ++events;
+  }
+
+  void flush() {
+    if(buffer.empty())
+      return;
+    iovec part;
+    part.iov_base = buffer.data();
+    part.iov_len = buffer.size();
+    detail::writeAll(fd, &part, 1);
+    buffer.clear();
+  }
+
+private:
+  void writeVarint(std::uint64_t value) {
+    while(value >= 0x80) {
+      buffer.push_back(static_cast<std::uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    buffer.push_back(static_cast<std::uint8_t>(value));
+  }
+
+  int fd;
+  std::vector<std::uint8_t> buffer;
+  std::uint64_t events;
+};
+
+// Decodes a trace chunk by chunk; next() returns false at the end.
+class TraceReader
+{
+public:
+  explicit TraceReader(int descriptor) : fd(descriptor), buffer(detail::TRACE_BUFFER_BYTES), begin(0), end(0) {
+    detail::TraceHeader header;
+    if(detail::readAll(fd, &header, sizeof(header)) != sizeof(header))
+      throw std::runtime_error("Trace ended inside the header");
+    if(std::memcmp(header.magic, "AIST", 4) != 0)
+      throw std::runtime_error("Trace has a wrong magic number");
+    if(header.version != detail::TRACE_VERSION)
+      throw std::runtime_error("Trace has an unsupported version");
+  }
+
+  bool next(TraceEvent& event) {
+    int byte = readByte();
+    if(byte < 0)
+      return false;
+    if(byte > static_cast<int>(TraceOp::Iterate))
+      throw std::runtime_error("Trace holds an unknown operation");
+    event.op = static_cast<TraceOp>(byte);
+    event.position = event.op == TraceOp::Insert || event.op == TraceOp::Erase ? readVarint() : 0;
+    event.count = event.op == TraceOp::Erase ? readVarint() : 0;
+    return true;
+  }
+
+  std::vector<TraceEvent> readAll() {
+    std::vector<TraceEvent> events;
+    TraceEvent event;
+    while(next(event))
+      events.push_back(event);
+    return events;
+  }
+
+private:
+  int readByte() { // -1 at the end of the stream
+    if(begin == end) {
+      begin = 0;
+      end = detail::readAll(fd, buffer.data(), buffer.size());
+      if(!end)
+        return -1;
+    }
+    return buffer[begin++];
+  }
+
+  std::uint64_t readVarint() {
+    std::uint64_t value = 0;
+    for(int shift = 0; shift < 64; shift += 7) {
+      int byte = readByte();
+      if(byte < 0)
+        throw std::runtime_error("Trace ended inside a record");
+      value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+      if(!(byte & 0x80))
+        return value;
+    }
+    throw std::runtime_error("Trace holds a malformed position");
+  }
+
+  int fd;
+  std::vector<std::uint8_t> buffer;
+  std::size_t begin;
+  std::size_t end;
+};
+
+// Checks that every position fits the container size the trace implies, so
+// a replay never has to; returns the largest size reached. Erases of zero
+// elements are accepted and left to the replay to skip.
+inline std::uint64_t validateTrace(const std::vector<TraceEvent>& events) {
+  std::uint64_t size = 0, peak = 0;
+  for(const TraceEvent& e : events) {
+    switch(e.op) {
+      case TraceOp::Append:
+      case TraceOp::Prepend:
+        ++size;
+        break;
+      case TraceOp::Insert:
+        if(e.position > size)
+          throw std::runtime_error("Trace inserts out of range");
+        ++size;
+        break;
+      case TraceOp::PopFirst:
+      case TraceOp::PopLast:
+        if(!size)
+          throw std::runtime_error("Trace pops from an empty container");
+        --size;
+        break;
+      case TraceOp::Erase:
+        if(e.position > size || e.count > size - e.position)
+          throw std::runtime_error("Trace erases out of range");
+        size -= e.count;
+        break;
+      case TraceOp::Iterate:
+        break;
+    }
+    if(size > peak)
+      peak = size;
+  }
+  return peak;
+}
+
+// Opt-in recording wrapper. The container stays reachable through get() for
+// reads; mutations must go through the wrapper to be logged. Positions are
+// found by walking from begin, so recording a LinkedList insert or erase is
+// O(position) instead of O(1).
+template <typename Container>
+class Recording
+{
+public:
+  using value_type = typename Container::value_type;
+  using size_type = typename Container::size_type;
+  using const_iterator = typename Container::const_iterator;
+
+  explicit Recording(TraceWriter& traceWriter) : writer(&traceWriter) {}
+
+  Recording(TraceWriter& traceWriter, const Container& initial) : container(initial), writer(&traceWriter) {
+    for(size_type i = 0; i < container.getSize(); ++i)
+      writer->record(TraceOp::Append);
+  }
+
+  const Container& get() const {
+    return container;
+  }
+
+  bool isEmpty() const {
+    return container.isEmpty();
+  }
+
+  size_type getSize() const {
+    return container.getSize();
+  }
+
+  void append(const value_type& item) {
+    container.append(item);
+    writer->record(TraceOp::Append);
+  }
+
+  void prepend(const value_type& item) {
+    container.prepend(item);
+    writer->record(TraceOp::Prepend);
+  }
+
+  void insert(const const_iterator& insertPosition, const value_type& item) {
+    std::uint64_t position = indexOf(insertPosition);
+    container.insert(insertPosition, item);
+    writer->record(TraceOp::Insert, position);
+  }
+
+  value_type popFirst() {
+    value_type item = container.popFirst();
+    writer->record(TraceOp::PopFirst);
+    return item;
+  }
+
+  value_type popLast() {
+    value_type item = container.popLast();
+    writer->record(TraceOp::PopLast);
+    return item;
+  }
+
+  void erase(const const_iterator& position) {
+    std::uint64_t index = indexOf(position);
+    container.erase(position);
+    writer->record(TraceOp::Erase, index, 1);
+  }
+
+  void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded) {
+    std::uint64_t first = indexOf(firstIncluded);
+    std::uint64_t count = std::distance(firstIncluded, lastExcluded);
+    container.erase(firstIncluded, lastExcluded);
+    if(count) // an empty range changes nothing, and not every container accepts it
+      writer->record(TraceOp::Erase, first, count);
+  }
+
+  // A full pass over the elements, logged as one Iterate event.
+  template <typename Visitor>
+  void forEach(Visitor visitor) const {
+    for(const value_type& item : container)
+      visitor(item);
+    writer->record(TraceOp::Iterate);
+  }
+
+  const_iterator cbegin() const {
+    return container.cbegin();
+  }
+
+  const_iterator cend() const {
+    return container.cend();
+  }
+
+  const_iterator begin() const {
+    return cbegin();
+  }
+
+  const_iterator end() const {
+    return cend();
+  }
+
+private:
+  std::uint64_t indexOf(const const_iterator& position) const {
+    return std::distance(container.cbegin(), position);
+  }
+
+  Container container;
+  TraceWriter* writer;
+};
+
+}
+
+#endif // AISDI_LINEAR_TRACE_H
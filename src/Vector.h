@@ -3,18 +3,39 @@
 
 #define START_SIZE 10
 
+#include <climits>
 #include <cstddef>
+#include <cstdint>
 #include <initializer_list>
 #include <stdexcept>
+#include <utility>
 
+#include "Allocation.h"
+#include "ContainerStats.h"
+#include "Edits.h"
+#include "Reclaimer.h"
+#include "SimdKernels.h"
+#include "Span.h"
 
 
 namespace aisdi
 {
 
 template <typename Type>
-class Vector
+class CowVector;
+
+// Buffers are aligned to Alignment bytes (at least alignof(Type)), so SIMD
+// kernels can rely on alignedData(). With setHugePages(true), buffers of
+// detail::HUGE_PAGE_SIZE and more are mapped and backed by huge pages.
+// Stats = CountingStats records allocations and copies, see stats().
+// adopt() and release() move whole buffers in and out without copying;
+// destroyAsync() releases the buffer to a Reclaimer thread.
+template <typename Type, std::size_t Alignment = 64, typename Stats = NoStats>
+class Vector : private Stats
 {
+  static_assert(Alignment && !(Alignment & (Alignment - 1)), "Alignment must be a power of two");
+  static_assert(Alignment <= detail::MAX_BUFFER_ALIGNMENT, "Alignment must not exceed a page");
+
 public:
   using difference_type = std::ptrdiff_t;
   using size_type = std::size_t;
@@ -29,10 +50,25 @@ public:
   using iterator = Iterator;
   using const_iterator = ConstIterator;
 
+  static const size_type ALIGNMENT = Alignment < alignof(Type) ? alignof(Type) : Alignment;
+
+  // Frees a buffer of capacity elements, including destroying them.
+  using BufferDeleter = void (*)(Type* data, size_type capacity);
+
+  // A buffer handed out by release(); the receiver calls deleter(data, capacity).
+  struct Buffer {
+    Type* data;
+    size_type size;
+    size_type capacity;
+    BufferDeleter deleter;
+  };
+
   Vector() {
     size = 0;
     capacity = START_SIZE;
-    buffer = new Type[START_SIZE+1]; // +1 to have element after last data element
+    hugePages = false;
+    deleter = nullptr;
+    buffer = allocate(START_SIZE); // one more element after last data element
   }
 
   Vector(std::initializer_list<Type> l) : Vector() {
@@ -41,51 +77,57 @@ public:
   }
 
   Vector(const Vector& other) : Vector() {
-    for(const_iterator it = other.cbegin(); it != other.cend(); it++ )
-      append(*it);
+    *this = other;
   }
 
   Vector(Vector&& other) {
     size = other.size;
     capacity = other.capacity;
     buffer = other.buffer;
+    hugePages = other.hugePages;
+    deleter = other.deleter;
 
     //reinitiliaze
     other.size = 0;
     other.capacity = START_SIZE;
-    other.buffer = new Type[START_SIZE+1];
+    other.buffer = other.allocate(START_SIZE);
+    other.deleter = nullptr;
 
   }
 
   ~Vector() {
-    delete [] buffer;
+    freeBuffer(buffer, capacity);
   }
 
   Vector& operator=(const Vector& other) {
     if(this == &other)
       return *this;
-    if(!isEmpty())
-      size =0; //faster than erase(cbegin,cend)
-    for(const_iterator it = other.cbegin();it != other.cend() ; ++it )
-      append(*it);
+    size = 0; // old contents are overwritten, so a new buffer starts empty
+    if(other.size > capacity)
+      replaceBuffer(allocate(other.size), other.size);
+    for(int i = 0; i < other.size; ++i)
+      buffer[i] = other.buffer[i];
+    size = other.size;
     return *this;
   }
 
   Vector& operator=(Vector&& other) {
     if(this == &other)
       return *this;
-    Type* toDel = buffer;
+    freeBuffer(buffer, capacity);
 
     size = other.size;
     capacity = other.capacity;
+    hugePages = other.hugePages;
+    deleter = other.deleter;
 
     buffer = other.buffer;
 
     other.size = 0;
     other.capacity = START_SIZE;
-    other.buffer = new Type[START_SIZE+1];
+    other.buffer = other.allocate(START_SIZE);
+    other.deleter = nullptr;
 
-    delete [] toDel;
     return *this;
   }
 
@@ -97,17 +139,158 @@ public:
     return size;
   }
 
+  pointer data() {
+    return buffer;
+  }
+
+  const_pointer data() const {
+    return buffer;
+  }
+
+  // Same buffer as data(), with its ALIGNMENT made known to the compiler.
+  pointer alignedData() {
+    return static_cast<pointer>(__builtin_assume_aligned(buffer, ALIGNMENT));
+  }
+
+  const_pointer alignedData() const {
+    return static_cast<const_pointer>(__builtin_assume_aligned(buffer, ALIGNMENT));
+  }
+
+  Span<Type> span() {
+    return Span<Type>(buffer, size);
+  }
+
+  Span<const Type> span() const {
+    return Span<const Type>(buffer, size);
+  }
+
+  Span<Type> subspan(size_type first, size_type count) {
+    return span().subspan(first, count);
+  }
+
+  Span<const Type> subspan(size_type first, size_type count) const {
+    return span().subspan(first, count);
+  }
+
+  // Constructed slots past the last element, to be filled in place, e.g. by
+  // read(); appendSpare(count) then turns the first count of them into
+  // elements without copying.
+  Span<Type> spare() {
+    return Span<Type>(buffer + size, capacity - size);
+  }
+
+  void appendSpare(size_type count) {
+    if(count > static_cast<size_type>(capacity - size))
+      throw std::out_of_range("Attempt to append more than the spare capacity");
+    size += static_cast<int>(count);
+  }
+
+  // Takes over a buffer filled elsewhere, e.g. by the I/O layer, instead of
+  // appending its elements. All capacity elements must be constructed objects
+  // (any bytes will do for trivial types) and data must be ALIGNMENT aligned.
+  // deleter(data, capacity) runs when the vector outgrows or drops the buffer.
+  void adopt(Type* data, size_type newSize, size_type newCapacity, BufferDeleter newDeleter) {
+    if(!data || !newDeleter)
+      throw std::invalid_argument("Attempt to adopt buffer without data or deleter");
+    if(!newCapacity || newSize > newCapacity || newCapacity > static_cast<size_type>(INT_MAX))
+      throw std::out_of_range("Attempt to adopt buffer with invalid size or capacity");
+    if(reinterpret_cast<std::uintptr_t>(data) % ALIGNMENT)
+      throw std::invalid_argument("Attempt to adopt misaligned buffer");
+    freeBuffer(buffer, capacity);
+    buffer = data;
+    size = static_cast<int>(newSize);
+    capacity = static_cast<int>(newCapacity);
+    deleter = newDeleter;
+  }
+
+  // Hands the buffer out together with the deleter that frees it and leaves
+  // the vector empty.
+  Buffer release() {
+    Buffer released = { buffer, static_cast<size_type>(size), static_cast<size_type>(capacity), deleter };
+    if(!deleter) {
+      released.deleter = hugePages ? &freeOwned<true> : &freeOwned<false>;
+      Stats::onFree();
+    }
+    size = 0;
+    capacity = START_SIZE;
+    deleter = nullptr;
+    buffer = allocate(START_SIZE);
+    return released;
+  }
+
+  // Leaves the vector empty and destroys the elements and frees the old
+  // buffer on the reclaimer's thread; an adopted buffer's deleter runs there.
+  void destroyAsync(Reclaimer& reclaimer = Reclaimer::global()) {
+    Buffer released = release();
+    reclaimer.submit([released] { released.deleter(released.data, released.capacity); });
+  }
+
+  bool ownsBuffer() const { // false while holding an adopted buffer
+    return !deleter;
+  }
+
+  void swap(Vector& other) {
+    std::swap(buffer, other.buffer);
+    std::swap(size, other.size);
+    std::swap(capacity, other.capacity);
+    std::swap(hugePages, other.hugePages);
+    std::swap(deleter, other.deleter);
+  }
+
+  void reserve(size_type newCapacity) { // never shrinks
+    if(newCapacity <= static_cast<size_type>(capacity))
+      return;
+    if(newCapacity >= static_cast<size_type>(INT_MAX)) // the buffer holds capacity + 1
+      throw std::out_of_range("Attempt to reserve more than a vector can hold");
+    moveToBuffer(static_cast<int>(newCapacity));
+  }
+
+  bool usesHugePages() const {
+    return hugePages;
+  }
+
+  const Stats& stats() const {
+    return *this;
+  }
+
+  // Estimated footprint; allocator bytes assume glibc-style chunk headers and
+  // are left out for adopted buffers, whose allocator is not known.
+  MemoryUsage memoryUsage() const {
+    MemoryUsage usage;
+    size_type bufferBytes = (capacity + (deleter ? 0 : 1)) * sizeof(Type);
+    usage.usedBytes = size * sizeof(Type);
+    usage.slackBytes = bufferBytes - usage.usedBytes;
+    usage.overheadBytes = sizeof(*this);
+    usage.allocatorBytes = deleter ? 0 : detail::allocationOverhead(bufferBytes, hugePages);
+    usage.allocations = 1;
+    return usage;
+  }
+
+  // Opt-in huge-page backing for large buffers; moves the contents to a buffer
+  // allocated under the new setting.
+  void setHugePages(bool enable) {
+    if(enable == hugePages)
+      return;
+    Type* tmp = detail::allocateElements<Type>(capacity + 1, ALIGNMENT, enable);
+    Stats::onAllocate(capacity);
+    Stats::onReallocate();
+    Stats::onCopy(size, size * sizeof(Type));
+    for(int i = 0; i < size; ++i)
+      tmp[i] = buffer[i];
+    freeBuffer(buffer, capacity);
+    buffer = tmp;
+    hugePages = enable;
+  }
+
   void append(const Type& item) {
     if(size == capacity) { //if vector is full
       Type* tmp = resize(); // 2 times bigger
-      Type* toDel = buffer;
       Type* helper = tmp;
 
       for(const_iterator it = cbegin();it!=cend();++it, ++tmp)
         *tmp = *it;
 
-      buffer = helper;
-      delete [] toDel;
+      replaceBuffer(helper, 2 * capacity);
     }
 
     buffer[size] = item;
@@ -117,7 +300,6 @@ public:
   void prepend(const Type& item) {
     if(size == capacity) {
       Type* tmp = resize();
-      Type* toDel = buffer;
 
       *tmp = item;
       Type* helper = tmp;
@@ -125,8 +307,7 @@ public:
       ++tmp;
       for(; it!= cend(); ++tmp, ++it)
         *tmp = *it;
-      buffer = helper;
-      delete [] toDel;
+      replaceBuffer(helper, 2 * capacity);
       ++size;
     }
     else {
@@ -143,7 +324,6 @@ public:
     }
     if(size == capacity) {
       Type* tmp = resize();
-      Type* toDel = buffer;
 
       Type* helper = tmp;
       const_iterator it = cbegin();
@@ -152,8 +332,7 @@ public:
       *tmp = item;
       for(++tmp; it != cend(); ++tmp, ++it)
         *tmp = *it;
-      buffer = helper;
-      delete [] toDel;
+      replaceBuffer(helper, 2 * capacity);
       ++size;
     }
     else { //right shift
@@ -207,6 +386,89 @@ public:
     size -= (lastExcluded.index - firstIncluded.index);
   }
 
+  // Keeps the elements not matching pred in order, moving each survivor at
+  // most once instead of shifting the tail per erase; returns how many were
+  // removed.
+  template <typename Predicate>
+  size_type removeIf(Predicate pred) {
+    int kept = 0;
+    size_type moved = 0;
+    for(int i = 0; i < size; ++i) {
+      if(pred(static_cast<const Type&>(buffer[i])))
+        continue;
+      if(kept != i) {
+        buffer[kept] = buffer[i];
+        ++moved;
+      }
+      ++kept;
+    }
+    Stats::onCopy(moved, moved * sizeof(Type));
+    size_type removed = size - kept;
+    size = kept;
+    return removed;
+  }
+
+  // Applies a batch of edits, sorted as Edits.h describes, in O(n + k):
+  // kept elements move at most once and the buffer is reallocated at most
+  // once. Without reallocation, elements moving down are moved front to back
+  // and elements moving up back to front, so neither overwrites the other.
+  template <typename Edits>
+  void applyEdits(const Edits& edits) {
+    detail::EditCounts counts = detail::checkEdits(edits, size);
+    size_type newSize = size + counts.inserts - counts.erases;
+    if(newSize > static_cast<size_type>(capacity)) {
+      int newCapacity = static_cast<int>(newSize > 2 * static_cast<size_type>(capacity) ? newSize : 2 * capacity);
+      Type* tmp = allocate(newCapacity);
+      mergeEdits(edits, tmp);
+      replaceBuffer(tmp, newCapacity);
+    }
+    else {
+      moveDownForEdits(edits);
+      moveUpForEdits(edits, static_cast<difference_type>(counts.inserts) - static_cast<difference_type>(counts.erases));
+      placeEdits(edits);
+    }
+    size = static_cast<int>(newSize);
+  }
+
+  // Search and reductions work on the buffer directly; int32_t, uint64_t,
+  // float and double use SIMD kernels picked from CPUID on first use.
+  const_iterator find(const Type& item) const {
+    return const_iterator(static_cast<int>(kernels::find(buffer, size, item)), this);
+  }
+
+  iterator find(const Type& item) {
+    return iterator(static_cast<int>(kernels::find(buffer, size, item)), this);
+  }
+
+  bool contains(const Type& item) const {
+    return kernels::find(buffer, size, item) != static_cast<size_type>(size);
+  }
+
+  size_type count(const Type& item) const {
+    return kernels::count(buffer, size, item);
+  }
+
+  difference_type indexOf(const Type& item) const { // -1 if not found
+    size_type index = kernels::find(buffer, size, item);
+    return index == static_cast<size_type>(size) ? -1 : static_cast<difference_type>(index);
+  }
+
+  Type min() const {
+    if(isEmpty())
+      throw std::logic_error("Attempt to get min of empty vector");
+    return kernels::min(buffer, size);
+  }
+
+  Type max() const {
+    if(isEmpty())
+      throw std::logic_error("Attempt to get max of empty vector");
+    return kernels::max(buffer, size);
+  }
+
+  Type sum() const {
+    return kernels::sum(buffer, size);
+  }
+
   iterator begin() {
     return iterator(0, this);
   }
@@ -233,14 +495,136 @@ public:
 
   protected:
 
-    Type* resize() { //use if vector is full
-      capacity *= 2;
-      return new Type[capacity+1];
+    using kernels = detail::SearchDispatch<Type>;
+
+    Type* allocate(int elements) { // +1 to have element after last data element
+      Type* allocated = detail::allocateElements<Type>(elements + 1, ALIGNMENT, hugePages);
+      Stats::onAllocate(elements);
+      return allocated;
+    }
+
+    void freeBuffer(Type* old, int elements) { // old is always buffer
+      if(deleter) {
+        deleter(old, elements);
+        deleter = nullptr;
+        return;
+      }
+      detail::releaseElements(old, elements + 1, hugePages);
+      Stats::onFree();
+    }
+
+    template <bool HugePages>
+    static void freeOwned(Type* data, size_type elements) {
+      detail::releaseElements(data, elements + 1, HugePages);
+    }
+
+    Type* resize() { //use if vector is full, then hand the result to replaceBuffer
+      return allocate(2 * capacity);
+    }
+
+    void replaceBuffer(Type* newBuffer, int newCapacity) { // after size elements were copied
+      Stats::onReallocate();
+      Stats::onCopy(size, size * sizeof(Type));
+      freeBuffer(buffer, capacity);
+      buffer = newBuffer;
+      capacity = newCapacity;
+    }
+
+    void moveToBuffer(int newCapacity) {
+      Type* tmp = allocate(newCapacity);
+      for(int i = 0; i < size; ++i)
+        tmp[i] = buffer[i];
+      replaceBuffer(tmp, newCapacity);
+    }
+
+    template <typename Edits>
+    void mergeEdits(const Edits& edits, Type* out) {
+      int from = 0;
+      for(const auto& edit : edits) {
+        for(; from < static_cast<int>(edit.position); ++from)
+          *out++ = buffer[from];
+        if(edit.op != EditOp::Erase)
+          *out++ = edit.value;
+        if(edit.op != EditOp::Insert)
+          ++from;
+      }
+      for(; from < size; ++from)
+        *out++ = buffer[from];
+    }
+
+    // Moves the elements going to a lower index; delta is the shift of the
+    // next element, changed by every insert before it and erase of it.
+    template <typename Edits>
+    void moveDownForEdits(const Edits& edits) {
+      difference_type delta = 0;
+      int from = 0;
+      size_type moved = 0;
+      for(const auto& edit : edits) {
+        int to = static_cast<int>(edit.position);
+        if(delta < 0) {
+          for(int i = from; i < to; ++i)
+            buffer[i + delta] = buffer[i];
+          moved += to - from;
+        }
+        from = to;
+        if(edit.op == EditOp::Insert)
+          ++delta;
+        else if(edit.op == EditOp::Erase) {
+          --delta;
+          ++from;
+        }
+      }
+      if(delta < 0) {
+        for(int i = from; i < size; ++i)
+          buffer[i + delta] = buffer[i];
+        moved += size - from;
+      }
+      Stats::onCopy(moved, moved * sizeof(Type));
+    }
+
+    // The same walk from the back for the elements going to a higher index.
+    template <typename Edits>
+    void moveUpForEdits(const Edits& edits, difference_type delta) {
+      int to = size;
+      size_type moved = 0;
+      for(auto it = edits.end(); it != edits.begin();) {
+        --it;
+        if((*it).op == EditOp::Replace)
+          continue;
+        int from = static_cast<int>((*it).position) + ((*it).op == EditOp::Erase ? 1 : 0);
+        if(delta > 0) {
+          for(int i = to - 1; i >= from; --i)
+            buffer[i + delta] = buffer[i];
+          moved += to - from;
+        }
+        to = static_cast<int>((*it).position);
+        delta += (*it).op == EditOp::Erase ? 1 : -1;
+      }
+      if(delta > 0) {
+        for(int i = to - 1; i >= 0; --i)
+          buffer[i + delta] = buffer[i];
+        moved += to;
+      }
+      Stats::onCopy(moved, moved * sizeof(Type));
+    }
+
+    template <typename Edits>
+    void placeEdits(const Edits& edits) {
+      difference_type delta = 0;
+      for(const auto& edit : edits) {
+        if(edit.op == EditOp::Erase)
+          --delta;
+        else
+          buffer[edit.position + delta] = edit.value;
+        if(edit.op == EditOp::Insert)
+          ++delta;
+      }
     }
 
     void leftShift(const const_iterator& positionTo, const const_iterator& positionFrom) {
       iterator to = iterator(positionTo.index, this);
       const_iterator from = positionFrom;
+      Stats::onCopy(size - from.index, (size - from.index) * sizeof(Type));
 
       for(; from != cend(); ++to, ++from)
         *to = *from;
@@ -252,6 +636,7 @@ public:
         return;
       }
       iterator it = end() - 1;
+      Stats::onCopy(size - position.index, (size - position.index) * sizeof(Type));
       ++size;
       for(; it != position; --it)
         *(it+1) = *it;
@@ -264,11 +649,13 @@ public:
     Type* buffer;
     int size;
     int capacity;
+    bool hugePages;
+    BufferDeleter deleter; // set while the buffer is adopted
 
 };
 
-template <typename Type>
-class Vector<Type>::ConstIterator
+template <typename Type, std::size_t Alignment, typename Stats>
+class Vector<Type, Alignment, Stats>::ConstIterator
 {
 public:
   using iterator_category = std::bidirectional_iterator_tag;
@@ -277,7 +664,7 @@ public:
   using pointer = typename Vector::const_pointer;
   using reference = typename Vector::const_reference;
 
-  explicit ConstIterator(int i = 0, const Vector<Type>* v = nullptr ) : index(i), vec(v)  {}
+  explicit ConstIterator(int i = 0, const Vector* v = nullptr ) : index(i), vec(v)  {}
 
   ConstIterator(const ConstIterator& iter) : index(iter.index), vec(iter.vec)  {}
 
@@ -351,20 +738,22 @@ public:
 
   protected:
     int index;
-    const Vector<value_type>* vec;
+    const Vector* vec;
 
-    friend void aisdi::Vector<Type>::erase(const const_iterator&, const const_iterator&);
-    friend void aisdi::Vector<Type>::leftShift(const const_iterator&, const const_iterator&);
+    friend void aisdi::Vector<Type, Alignment, Stats>::erase(const const_iterator&, const const_iterator&);
+    friend void aisdi::Vector<Type, Alignment, Stats>::leftShift(const const_iterator&, const const_iterator&);
+    friend void aisdi::Vector<Type, Alignment, Stats>::rightShift(const const_iterator&);
+    friend class aisdi::CowVector<Type>;
 };
 
-template <typename Type>
-class Vector<Type>::Iterator : public Vector<Type>::ConstIterator
+template <typename Type, std::size_t Alignment, typename Stats>
+class Vector<Type, Alignment, Stats>::Iterator : public Vector<Type, Alignment, Stats>::ConstIterator
 {
 public:
   using pointer = typename Vector::pointer;
   using reference = typename Vector::reference;
 
-  explicit Iterator(int i, const Vector<value_type>* v) : const_iterator(i, v) {}
+  explicit Iterator(int i, const Vector* v) : const_iterator(i, v) {}
 
   Iterator(const ConstIterator& other)
     : ConstIterator(other) {}
@@ -405,6 +794,14 @@ public:
   }
 };
 
+template <typename Type, std::size_t Alignment, typename Stats, typename Predicate>
+typename Vector<Type, Alignment, Stats>::size_type eraseIf(Vector<Type, Alignment, Stats>& vector, Predicate pred)
+{
+  return vector.removeIf(pred);
+}
+
 }
 
+#include "VectorBool.h"
+
 #endif // AISDI_LINEAR_VECTOR_H
@@ -0,0 +1,593 @@
+#ifndef AISDI_LINEAR_VECTORBOOL_H
+#define AISDI_LINEAR_VECTORBOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+
+#include "Vector.h"
+
+namespace aisdi
+{
+
+// Packed Vector<bool>: 64 flags per word, elements accessed through a proxy
+// Reference. Bits past size are always kept zero, so counting and bitwise
+// operations can work on whole words. Words are aligned like other buffers;
+// stats count words where other Vectors count elements.
+template <std::size_t Alignment, typename Stats>
+class Vector<bool, Alignment, Stats> : private Stats
+{
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = bool;
+  using word_type = std::uint64_t;
+  using const_reference = bool;
+
+  class Reference;
+  class ConstIterator;
+  class Iterator;
+  using reference = Reference;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  static const size_type WORD_BITS = 64;
+  static const size_type ALIGNMENT = Alignment < alignof(word_type) ? alignof(word_type) : Alignment;
+
+  class Reference
+  {
+  public:
+    Reference(word_type* w, word_type m) : word(w), mask(m) {}
+
+    operator bool() const {
+      return (*word & mask) != 0;
+    }
+
+    Reference& operator=(bool value) {
+      if(value)
+        *word |= mask;
+      else
+        *word &= ~mask;
+      return *this;
+    }
+
+    Reference& operator=(const Reference& other) {
+      return operator=(static_cast<bool>(other));
+    }
+
+    void flip() {
+      *word ^= mask;
+    }
+
+  private:
+    word_type* word;
+    word_type mask;
+  };
+
+  class ConstIterator
+  {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = bool;
+    using difference_type = Vector::difference_type;
+    using pointer = void;
+    using reference = bool;
+
+    explicit ConstIterator(size_type i = 0, const Vector* v = nullptr) : index(i), vec(v) {}
+
+    bool operator*() const {
+      if(index >= vec->size)
+        throw std::out_of_range("Attempt to dereference end iterator");
+      return vec->getBit(index);
+    }
+
+    ConstIterator& operator++() {
+      if(index == vec->size)
+        throw std::out_of_range("Attempt to increment end iterator");
+      ++index;
+      return *this;
+    }
+
+    ConstIterator operator++(int) {
+      ConstIterator result = *this;
+      operator++();
+      return result;
+    }
+
+    ConstIterator& operator--() {
+      if(index == 0)
+        throw std::out_of_range("Attempt to decrement begin iterator");
+      --index;
+      return *this;
+    }
+
+    ConstIterator operator--(int) {
+      ConstIterator result = *this;
+      operator--();
+      return result;
+    }
+
+    ConstIterator operator+(difference_type d) const {
+      if(index + d > vec->size)
+        throw std::out_of_range("Attempt to add out of vector range");
+      return ConstIterator(index + d, vec);
+    }
+
+    ConstIterator operator-(difference_type d) const {
+      if(d > static_cast<difference_type>(index))
+        throw std::out_of_range("Attempt to substract out of vector range");
+      return ConstIterator(index - d, vec);
+    }
+
+    bool operator==(const ConstIterator& other) const {
+      return vec == other.vec && index == other.index;
+    }
+
+    bool operator!=(const ConstIterator& other) const {
+      return !operator==(other);
+    }
+
+  protected:
+    size_type index;
+    const Vector* vec;
+
+    friend class Vector;
+  };
+
+  class Iterator : public ConstIterator
+  {
+  public:
+    using reference = Vector::Reference;
+
+    explicit Iterator(size_type i, const Vector* v) : ConstIterator(i, v) {}
+
+    Iterator(const ConstIterator& other)
+      : ConstIterator(other) {}
+
+    Iterator& operator++() {
+      ConstIterator::operator++();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto result = *this;
+      ConstIterator::operator++();
+      return result;
+    }
+
+    Iterator& operator--() {
+      ConstIterator::operator--();
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      auto result = *this;
+      ConstIterator::operator--();
+      return result;
+    }
+
+    Iterator operator+(difference_type d) const {
+      return ConstIterator::operator+(d);
+    }
+
+    Iterator operator-(difference_type d) const {
+      return ConstIterator::operator-(d);
+    }
+
+    Reference operator*() const {
+      ConstIterator::operator*(); // bounds check
+      return Reference(this->vec->words + this->index / WORD_BITS, word_type(1) << (this->index % WORD_BITS));
+    }
+  };
+
+  Vector() : words(allocateWords(1)), size(0), capacity(WORD_BITS) {}
+
+  Vector(std::initializer_list<bool> l) : Vector() {
+    for(auto it = l.begin(); it != l.end(); ++it)
+      append(*it);
+  }
+
+  Vector(const Vector& other)
+    : Stats(), words(allocateWords(other.capacity / WORD_BITS)), size(other.size), capacity(other.capacity) {
+    for(size_type i = 0; i < usedWords(); ++i)
+      words[i] = other.words[i];
+  }
+
+  Vector(Vector&& other) : words(other.words), size(other.size), capacity(other.capacity) {
+    //reinitialize
+    other.words = other.allocateWords(1);
+    other.size = 0;
+    other.capacity = WORD_BITS;
+  }
+
+  ~Vector() {
+    releaseWords(words, capacity);
+  }
+
+  Vector& operator=(const Vector& other) {
+    if(this == &other)
+      return *this;
+    if(capacity < other.size)
+      reallocate(other.capacity);
+    for(size_type i = 0; i < capacity / WORD_BITS; ++i)
+      words[i] = i < other.usedWords() ? other.words[i] : 0;
+    size = other.size;
+    return *this;
+  }
+
+  Vector& operator=(Vector&& other) {
+    if(this == &other)
+      return *this;
+    releaseWords(words, capacity);
+    words = other.words;
+    size = other.size;
+    capacity = other.capacity;
+    other.words = other.allocateWords(1);
+    other.size = 0;
+    other.capacity = WORD_BITS;
+    return *this;
+  }
+
+  bool isEmpty() const {
+    return !size;
+  }
+
+  size_type getSize() const {
+    return size;
+  }
+
+  const word_type* data() const {
+    return words;
+  }
+
+  const word_type* alignedData() const {
+    return static_cast<const word_type*>(__builtin_assume_aligned(words, ALIGNMENT));
+  }
+
+  size_type wordCount() const {
+    return usedWords();
+  }
+
+  const Stats& stats() const {
+    return *this;
+  }
+
+  // Used bytes cover the words holding flags, slack the unused words.
+  MemoryUsage memoryUsage() const {
+    MemoryUsage usage;
+    size_type bufferBytes = capacity / WORD_BITS * sizeof(word_type);
+    usage.usedBytes = usedWords() * sizeof(word_type);
+    usage.slackBytes = bufferBytes - usage.usedBytes;
+    usage.overheadBytes = sizeof(*this);
+    usage.allocatorBytes = detail::allocationOverhead(bufferBytes);
+    usage.allocations = 1;
+    return usage;
+  }
+
+  // Leaves the vector empty and frees the old words on the reclaimer's thread.
+  void destroyAsync(Reclaimer& reclaimer = Reclaimer::global()) {
+    word_type* old = words;
+    size_type oldWords = capacity / WORD_BITS;
+    words = allocateWords(1);
+    size = 0;
+    capacity = WORD_BITS;
+    Stats::onFree();
+    reclaimer.submit([old, oldWords] { detail::releaseElements(old, oldWords, false); });
+  }
+
+  void reserve(size_type newCapacity) { // in bits, never shrinks
+    if(newCapacity > capacity)
+      reallocate(newCapacity);
+  }
+
+  void append(bool item) {
+    if(size == capacity)
+      reallocate(2 * capacity);
+    setBit(size++, item);
+  }
+
+  void prepend(bool item) {
+    insertAt(0, item);
+  }
+
+  void insert(const const_iterator& insertPosition, bool item) {
+    insertAt(insertPosition.index, item);
+  }
+
+  bool popFirst() {
+    if(isEmpty())
+      throw std::logic_error("Attempt to pop first in empty vector");
+    bool first = getBit(0);
+    eraseAt(0);
+    return first;
+  }
+
+  bool popLast() {
+    if(isEmpty())
+      throw std::logic_error("Attempt to pop last in empty vector");
+    bool last = getBit(--size);
+    setBit(size, false);
+    return last;
+  }
+
+  void erase(const const_iterator& position) {
+    if(isEmpty())
+      throw std::out_of_range("attempt to erase empty vector");
+    if(position.index == size)
+      throw std::out_of_range("attempt to erase at end iterator");
+    eraseAt(position.index);
+  }
+
+  void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded) {
+    if(isEmpty())
+      throw std::out_of_range("attempt to erase empty vector");
+    size_type to = firstIncluded.index;
+    for(size_type from = lastExcluded.index; from < size; ++from, ++to)
+      setBit(to, getBit(from));
+    for(size_type i = to; i < size; ++i)
+      setBit(i, false);
+    size = to;
+  }
+
+  // Keeps the flags pred rejects in order, packing them into whole words as
+  // they are visited instead of shifting per erase; returns how many were
+  // removed. A word is only written once all its old flags have been read.
+  template <typename Predicate>
+  size_type removeIf(Predicate pred) {
+    size_type kept = 0;
+    word_type packed = 0;
+    for(size_type i = 0; i < size; ++i) {
+      bool flag = getBit(i);
+      if(pred(flag))
+        continue;
+      packed |= word_type(flag) << (kept % WORD_BITS);
+      if(++kept % WORD_BITS == 0) {
+        words[kept / WORD_BITS - 1] = packed;
+        packed = 0;
+      }
+    }
+    size_type used = usedWords();
+    size_type w = kept / WORD_BITS;
+    if(kept % WORD_BITS)
+      words[w++] = packed;
+    for(; w < used; ++w)
+      words[w] = 0;
+    size_type removed = size - kept;
+    size = kept;
+    return removed;
+  }
+
+  // Word-at-a-time queries.
+  size_type count(bool value = true) const {
+    size_type ones = 0;
+    for(size_type i = 0; i < usedWords(); ++i)
+      ones += __builtin_popcountll(words[i]);
+    return value ? ones : size - ones;
+  }
+
+  bool contains(bool value) const {
+    return find(value) != cend();
+  }
+
+  const_iterator find(bool value) const {
+    return const_iterator(value ? findFirst() : findFirstZero(), this);
+  }
+
+  // Index of the first set flag, getSize() if there is none.
+  size_type findFirst() const {
+    return scanFrom(0);
+  }
+
+  // Index of the first set flag after position, getSize() if there is none.
+  size_type findNext(size_type position) const {
+    return position + 1 >= size ? size : scanFrom(position + 1);
+  }
+
+  Vector& operator&=(const Vector& other) {
+    checkSameSize(other);
+    for(size_type i = 0; i < usedWords(); ++i)
+      words[i] &= other.words[i];
+    return *this;
+  }
+
+  Vector& operator|=(const Vector& other) {
+    checkSameSize(other);
+    for(size_type i = 0; i < usedWords(); ++i)
+      words[i] |= other.words[i];
+    return *this;
+  }
+
+  Vector& operator^=(const Vector& other) {
+    checkSameSize(other);
+    for(size_type i = 0; i < usedWords(); ++i)
+      words[i] ^= other.words[i];
+    return *this;
+  }
+
+  iterator begin() {
+    return iterator(0, this);
+  }
+
+  iterator end() {
+    return iterator(size, this);
+  }
+
+  const_iterator cbegin() const {
+    return const_iterator(0, this);
+  }
+
+  const_iterator cend() const {
+    return const_iterator(size, this);
+  }
+
+  const_iterator begin() const {
+    return cbegin();
+  }
+
+  const_iterator end() const {
+    return cend();
+  }
+
+private:
+  word_type* allocateWords(size_type count) { // zeroed
+    word_type* allocated = detail::allocateElements<word_type>(count, ALIGNMENT, false);
+    for(size_type i = 0; i < count; ++i)
+      allocated[i] = 0;
+    Stats::onAllocate(count);
+    return allocated;
+  }
+
+  void releaseWords(word_type* old, size_type bits) {
+    detail::releaseElements(old, bits / WORD_BITS, false);
+    Stats::onFree();
+  }
+
+  static word_type lowMask(size_type bits) { // bits below position `bits`
+    return bits ? ~word_type(0) >> (WORD_BITS - bits) : 0;
+  }
+
+  size_type usedWords() const {
+    return (size + WORD_BITS - 1) / WORD_BITS;
+  }
+
+  bool getBit(size_type index) const {
+    return (words[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+  }
+
+  void setBit(size_type index, bool value) {
+    word_type mask = word_type(1) << (index % WORD_BITS);
+    if(value)
+      words[index / WORD_BITS] |= mask;
+    else
+      words[index / WORD_BITS] &= ~mask;
+  }
+
+  void reallocate(size_type newCapacity) {
+    size_type newWords = (newCapacity + WORD_BITS - 1) / WORD_BITS;
+    word_type* tmp = allocateWords(newWords);
+    Stats::onReallocate();
+    Stats::onCopy(usedWords(), usedWords() * sizeof(word_type));
+    for(size_type i = 0; i < usedWords(); ++i)
+      tmp[i] = words[i];
+    releaseWords(words, capacity);
+    words = tmp;
+    capacity = newWords * WORD_BITS;
+  }
+
+  // Moves bits [index, size) one position up, carrying between words.
+  void insertAt(size_type index, bool item) {
+    if(index > size)
+      throw std::out_of_range("Attempt to insert out of vector range");
+    if(size == capacity)
+      reallocate(2 * capacity);
+    size_type first = index / WORD_BITS;
+    size_type last = size / WORD_BITS;
+    for(size_type w = last; w > first; --w)
+      words[w] = (words[w] << 1) | (words[w - 1] >> (WORD_BITS - 1));
+    word_type low = lowMask(index % WORD_BITS);
+    words[first] = (words[first] & low) | ((words[first] & ~low) << 1);
+    ++size;
+    setBit(index, item);
+  }
+
+  // Moves bits (index, size) one position down, carrying between words.
+  void eraseAt(size_type index) {
+    size_type first = index / WORD_BITS;
+    size_type last = usedWords() - 1;
+    word_type low = lowMask(index % WORD_BITS);
+    words[first] = (words[first] & low) | ((words[first] >> 1) & ~low);
+    for(size_type w = first; w < last; ++w) {
+      words[w] |= words[w + 1] << (WORD_BITS - 1);
+      words[w + 1] >>= 1;
+    }
+    --size;
+  }
+
+  size_type scanFrom(size_type index) const {
+    if(index >= size)
+      return size;
+    size_type w = index / WORD_BITS;
+    word_type bits = words[w] & ~lowMask(index % WORD_BITS);
+    while(!bits) {
+      if(++w == usedWords())
+        return size;
+      bits = words[w];
+    }
+    return w * WORD_BITS + __builtin_ctzll(bits);
+  }
+
+  size_type findFirstZero() const {
+    for(size_type w = 0; w < usedWords(); ++w) {
+      word_type zeros = ~words[w];
+      if(zeros) {
+        size_type index = w * WORD_BITS + __builtin_ctzll(zeros);
+        return index < size ? index : size;
+      }
+    }
+    return size;
+  }
+
+  void checkSameSize(const Vector& other) const {
+    if(other.size != size)
+      throw std::invalid_argument("Bitwise operation on vectors of different size");
+  }
+
+  word_type* words;
+  size_type size;
+  size_type capacity;
+};
+
+namespace detail
+{
+
+// A bool kept in a byte of its own, so a Vector of them hands out real
+// bool& where the packed Vector<bool> only has proxies.
+struct BoolByte {
+  BoolByte(bool v = false) : value(v) {}
+
+  operator bool() const {
+    return value;
+  }
+
+  bool value;
+};
+
+template <typename Type>
+struct Unpacked {
+  using type = Type;
+};
+
+template <>
+struct Unpacked<bool> {
+  using type = BoolByte;
+};
+
+template <typename Type>
+Type& unpacked(Type& item) {
+  return item;
+}
+
+template <typename Type>
+const Type& unpacked(const Type& item) {
+  return item;
+}
+
+inline bool& unpacked(BoolByte& item) {
+  return item.value;
+}
+
+inline const bool& unpacked(const BoolByte& item) {
+  return item.value;
+}
+
+}
+
+// Vector with one Type per element even for bool, for containers that
+// return Type& into the buffer; read elements through detail::unpacked().
+template <typename Type>
+using UnpackedVector = Vector<typename detail::Unpacked<Type>::type>;
+
+}
+
+#endif // AISDI_LINEAR_VECTORBOOL_H
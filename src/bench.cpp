@@ -0,0 +1,567 @@
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "AdaptiveSequence.h"
+#include "BTreeSequence.h"
+#include "Benchmark.h"
+#include "BufferCache.h"
+#include "IncrementalVector.h"
+#include "LinkedList.h"
+#include "Trace.h"
+#include "Vector.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+
+using aisdi::bench::LatencyResult;
+using aisdi::bench::MemoryResult;
+using aisdi::bench::Options;
+using aisdi::bench::Result;
+using aisdi::bench::Timing;
+using aisdi::bench::doNotOptimize;
+using aisdi::bench::measure;
+
+// Uniform access to the measured containers. LINEAR_FRONT marks containers
+// where prepend and popFirst are O(n) per operation.
+template <typename Container>
+struct Ops;
+
+template <typename T>
+struct Ops<aisdi::Vector<T>>
+{
+  static const char* name() { return "Vector"; }
+  static const bool LINEAR_FRONT = true;
+  static void append(aisdi::Vector<T>& c, const T& v) { c.append(v); }
+  static void prepend(aisdi::Vector<T>& c, const T& v) { c.prepend(v); }
+  static void popFirst(aisdi::Vector<T>& c) { c.popFirst(); }
+  static void popLast(aisdi::Vector<T>& c) { c.popLast(); }
+  static void insertMiddle(aisdi::Vector<T>& c, const T& v) { c.insert(c.cbegin() + c.getSize() / 2, v); }
+  static void insertAt(aisdi::Vector<T>& c, std::size_t i, const T& v) { c.insert(c.cbegin() + i, v); }
+  static void eraseAt(aisdi::Vector<T>& c, std::size_t i, std::size_t n) { c.erase(c.cbegin() + i, c.cbegin() + (i + n)); }
+};
+
+template <typename T>
+struct Ops<aisdi::IncrementalVector<T>>
+{
+  static const char* name() { return "IncrVector"; }
+  static const bool LINEAR_FRONT = true;
+  static void append(aisdi::IncrementalVector<T>& c, const T& v) { c.append(v); }
+  static void prepend(aisdi::IncrementalVector<T>& c, const T& v) { c.prepend(v); }
+  static void popFirst(aisdi::IncrementalVector<T>& c) { c.popFirst(); }
+  static void popLast(aisdi::IncrementalVector<T>& c) { c.popLast(); }
+  static void insertMiddle(aisdi::IncrementalVector<T>& c, const T& v) { c.insert(c.cbegin() + c.getSize() / 2, v); }
+  static void insertAt(aisdi::IncrementalVector<T>& c, std::size_t i, const T& v) { c.insert(c.cbegin() + i, v); }
+  static void eraseAt(aisdi::IncrementalVector<T>& c, std::size_t i, std::size_t n) { c.erase(c.cbegin() + i, c.cbegin() + (i + n)); }
+};
+
+template <typename T>
+struct Ops<aisdi::LinkedList<T>>
+{
+  static const char* name() { return "LinkedList"; }
+  static const bool LINEAR_FRONT = false;
+  static void append(aisdi::LinkedList<T>& c, const T& v) { c.append(v); }
+  static void prepend(aisdi::LinkedList<T>& c, const T& v) { c.prepend(v); }
+  static void popFirst(aisdi::LinkedList<T>& c) { c.popFirst(); }
+  static void popLast(aisdi::LinkedList<T>& c) { c.popLast(); }
+  static void insertMiddle(aisdi::LinkedList<T>& c, const T& v) { c.insert(c.cbegin() + c.getSize() / 2, v); }
+  static void insertAt(aisdi::LinkedList<T>& c, std::size_t i, const T& v) { c.insert(c.cbegin() + i, v); }
+  static void eraseAt(aisdi::LinkedList<T>& c, std::size_t i, std::size_t n) { c.erase(c.cbegin() + i, c.cbegin() + (i + n)); }
+};
+
+template <typename T>
+struct Ops<aisdi::AdaptiveSequence<T>>
+{
+  static const char* name() { return "Adaptive"; }
+  static const bool LINEAR_FRONT = false;
+  static void append(aisdi::AdaptiveSequence<T>& c, const T& v) { c.append(v); }
+  static void prepend(aisdi::AdaptiveSequence<T>& c, const T& v) { c.prepend(v); }
+  static void popFirst(aisdi::AdaptiveSequence<T>& c) { c.popFirst(); }
+  static void popLast(aisdi::AdaptiveSequence<T>& c) { c.popLast(); }
+  static void insertMiddle(aisdi::AdaptiveSequence<T>& c, const T& v) { c.insert(c.cbegin() + c.getSize() / 2, v); }
+  static void insertAt(aisdi::AdaptiveSequence<T>& c, std::size_t i, const T& v) { c.insert(c.cbegin() + i, v); }
+  static void eraseAt(aisdi::AdaptiveSequence<T>& c, std::size_t i, std::size_t n) { c.erase(c.cbegin() + i, c.cbegin() + (i + n)); }
+};
+
+template <typename T>
+struct Ops<aisdi::BTreeSequence<T>>
+{
+  static const char* name() { return "BTreeSeq"; }
+  static const bool LINEAR_FRONT = false;
+  static void append(aisdi::BTreeSequence<T>& c, const T& v) { c.append(v); }
+  static void prepend(aisdi::BTreeSequence<T>& c, const T& v) { c.prepend(v); }
+  static void popFirst(aisdi::BTreeSequence<T>& c) { c.popFirst(); }
+  static void popLast(aisdi::BTreeSequence<T>& c) { c.popLast(); }
+  static void insertMiddle(aisdi::BTreeSequence<T>& c, const T& v) { c.insert(c.getSize() / 2, v); }
+  static void insertAt(aisdi::BTreeSequence<T>& c, std::size_t i, const T& v) { c.insert(i, v); }
+  static void eraseAt(aisdi::BTreeSequence<T>& c, std::size_t i, std::size_t n) { c.erase(c.cbegin() + i, c.cbegin() + (i + n)); }
+};
+
+template <typename T>
+struct Ops<std::vector<T>>
+{
+  static const char* name() { return "std::vector"; }
+  static const bool LINEAR_FRONT = true;
+  static void append(std::vector<T>& c, const T& v) { c.push_back(v); }
+  static void prepend(std::vector<T>& c, const T& v) { c.insert(c.begin(), v); }
+  static void popFirst(std::vector<T>& c) { c.erase(c.begin()); }
+  static void popLast(std::vector<T>& c) { c.pop_back(); }
+  static void insertMiddle(std::vector<T>& c, const T& v) { c.insert(c.begin() + c.size() / 2, v); }
+  static void insertAt(std::vector<T>& c, std::size_t i, const T& v) { c.insert(c.begin() + i, v); }
+  static void eraseAt(std::vector<T>& c, std::size_t i, std::size_t n) { c.erase(c.begin() + i, c.begin() + (i + n)); }
+};
+
+template <typename T>
+struct Ops<std::deque<T>>
+{
+  static const char* name() { return "std::deque"; }
+  static const bool LINEAR_FRONT = false;
+  static void append(std::deque<T>& c, const T& v) { c.push_back(v); }
+  static void prepend(std::deque<T>& c, const T& v) { c.push_front(v); }
+  static void popFirst(std::deque<T>& c) { c.pop_front(); }
+  static void popLast(std::deque<T>& c) { c.pop_back(); }
+  static void insertMiddle(std::deque<T>& c, const T& v) { c.insert(c.begin() + c.size() / 2, v); }
+  static void insertAt(std::deque<T>& c, std::size_t i, const T& v) { c.insert(c.begin() + i, v); }
+  static void eraseAt(std::deque<T>& c, std::size_t i, std::size_t n) { c.erase(c.begin() + i, c.begin() + (i + n)); }
+};
+
+template <typename T>
+struct Ops<std::list<T>>
+{
+  static const char* name() { return "std::list"; }
+  static const bool LINEAR_FRONT = false;
+  static void append(std::list<T>& c, const T& v) { c.push_back(v); }
+  static void prepend(std::list<T>& c, const T& v) { c.push_front(v); }
+  static void popFirst(std::list<T>& c) { c.pop_front(); }
+  static void popLast(std::list<T>& c) { c.pop_back(); }
+  static void insertMiddle(std::list<T>& c, const T& v) { c.insert(std::next(c.begin(), c.size() / 2), v); }
+  static void insertAt(std::list<T>& c, std::size_t i, const T& v) { c.insert(std::next(c.begin(), i), v); }
+  static void eraseAt(std::list<T>& c, std::size_t i, std::size_t n) { c.erase(std::next(c.begin(), i), std::next(c.begin(), i + n)); }
+};
+
+template <typename T>
+T valueOf(std::size_t i)
+{
+  return T(static_cast<std::int32_t>(i));
+}
+
+template <typename Container>
+Container filledWith(std::size_t size)
+{
+  using T = typename Container::value_type;
+  Container container;
+  for(std::size_t i = 0; i < size; ++i)
+    Ops<Container>::append(container, valueOf<T>(i));
+  return container;
+}
+
+// The containers' own footprint estimate; the standard ones have none.
+template <typename T>
+double estimatedBytes(const aisdi::Vector<T>& c)
+{
+  return static_cast<double>(c.memoryUsage().totalBytes());
+}
+
+template <typename T>
+double estimatedBytes(const aisdi::LinkedList<T>& c)
+{
+  return static_cast<double>(c.memoryUsage().totalBytes());
+}
+
+template <typename Container>
+double estimatedBytes(const Container&)
+{
+  return -1;
+}
+
+// Middle inserts walk or shift O(n) elements each, so only a few are timed.
+const std::size_t MIDDLE_INSERTS = 100;
+
+template <typename Container>
+void benchContainer(const Options& options, const char* type, std::vector<Result>& results)
+{
+  using T = typename Container::value_type;
+  using O = Ops<Container>;
+  auto record = [&](const char* operation, std::size_t size, const Timing& timing) {
+    results.push_back(Result{ O::name(), type, operation, size, timing });
+  };
+
+  for(std::size_t size : options.sizes) {
+    auto empty = [] { return Container(); };
+    auto filled = [size] { return filledWith<Container>(size); };
+    bool quadraticAllowed = size <= options.maxQuadraticSize;
+
+    record("append", size, measure(options, size, empty, [size](Container& c) {
+      for(std::size_t i = 0; i < size; ++i)
+        O::append(c, valueOf<T>(i));
+    }));
+    record("popLast", size, measure(options, size, filled, [size](Container& c) {
+      for(std::size_t i = 0; i < size; ++i)
+        O::popLast(c);
+    }));
+    if(!O::LINEAR_FRONT || quadraticAllowed) {
+      record("prepend", size, measure(options, size, empty, [size](Container& c) {
+        for(std::size_t i = 0; i < size; ++i)
+          O::prepend(c, valueOf<T>(i));
+      }));
+      record("popFirst", size, measure(options, size, filled, [size](Container& c) {
+        for(std::size_t i = 0; i < size; ++i)
+          O::popFirst(c);
+      }));
+    }
+    record("iterate", size, measure(options, size, filled, [](Container& c) {
+      const Container& view = c;
+      T total = T();
+      for(const T& value : view)
+        total += value;
+      doNotOptimize(total);
+    }));
+    if(quadraticAllowed)
+      record("insertMiddle", size, measure(options, MIDDLE_INSERTS, filled, [](Container& c) {
+        for(std::size_t i = 0; i < MIDDLE_INSERTS; ++i)
+          O::insertMiddle(c, valueOf<T>(i));
+      }));
+  }
+}
+
+// Same operations as the timing mode, each timed on its own. Removal and
+// middle inserts start from a filled container, so their first operation
+// indices count down from size.
+template <typename Container>
+void benchContainer(const Options& options, const char* type, std::vector<LatencyResult>& results)
+{
+  using T = typename Container::value_type;
+  using O = Ops<Container>;
+  auto record = [&](const char* operation, std::size_t size, const aisdi::LatencyHistogram& histogram) {
+    results.push_back(LatencyResult{ O::name(), type, operation, size, options.latencyBatch, histogram });
+  };
+
+  for(std::size_t size : options.sizes) {
+    auto empty = [] { return Container(); };
+    auto filled = [size] { return filledWith<Container>(size); };
+    bool quadraticAllowed = size <= options.maxQuadraticSize;
+
+    record("append", size, aisdi::bench::measureLatency(options, size, empty, [](Container& c, std::size_t i) {
+      O::append(c, valueOf<T>(i));
+    }));
+    record("popLast", size, aisdi::bench::measureLatency(options, size, filled, [](Container& c, std::size_t) {
+      O::popLast(c);
+    }));
+    if(!O::LINEAR_FRONT || quadraticAllowed) {
+      record("prepend", size, aisdi::bench::measureLatency(options, size, empty, [](Container& c, std::size_t i) {
+        O::prepend(c, valueOf<T>(i));
+      }));
+      record("popFirst", size, aisdi::bench::measureLatency(options, size, filled, [](Container& c, std::size_t) {
+        O::popFirst(c);
+      }));
+    }
+    if(quadraticAllowed)
+      record("insertMiddle", size,
+             aisdi::bench::measureLatency(options, MIDDLE_INSERTS, filled, [](Container& c, std::size_t i) {
+               O::insertMiddle(c, valueOf<T>(i));
+             }));
+  }
+}
+
+template <typename Container>
+void benchContainer(const Options& options, const char* type, std::vector<MemoryResult>& results)
+{
+  for(std::size_t size : options.sizes) {
+    MemoryResult result = aisdi::bench::measureResident(size, [size](double& residentAfter) {
+      Container container = filledWith<Container>(size);
+      residentAfter = aisdi::bench::residentBytes();
+      return estimatedBytes(container);
+    });
+    result.container = Ops<Container>::name();
+    result.type = type;
+    results.push_back(result);
+  }
+}
+
+// Replays a recorded trace, already checked by validateTrace, from an empty
+// container; values are derived from the event index.
+template <typename Container>
+void replay(Container& c, const std::vector<aisdi::TraceEvent>& events)
+{
+  using T = typename Container::value_type;
+  using O = Ops<Container>;
+  for(std::size_t i = 0; i < events.size(); ++i) {
+    const aisdi::TraceEvent& e = events[i];
+    switch(e.op) {
+      case aisdi::TraceOp::Append:
+        O::append(c, valueOf<T>(i));
+        break;
+      case aisdi::TraceOp::Prepend:
+        O::prepend(c, valueOf<T>(i));
+        break;
+      case aisdi::TraceOp::Insert:
+        O::insertAt(c, e.position, valueOf<T>(i));
+        break;
+      case aisdi::TraceOp::PopFirst:
+        O::popFirst(c);
+        break;
+      case aisdi::TraceOp::PopLast:
+        O::popLast(c);
+        break;
+      case aisdi::TraceOp::Erase:
+        if(e.count)
+          O::eraseAt(c, e.position, e.count);
+        break;
+      case aisdi::TraceOp::Iterate: {
+        const Container& view = c;
+        T total = T();
+        for(const T& value : view)
+          total += value;
+        doNotOptimize(total);
+        break;
+      }
+    }
+  }
+}
+
+template <typename Container>
+void benchContainer(const Options& options, const char* type, const std::vector<aisdi::TraceEvent>& events,
+                    std::vector<Result>& results)
+{
+  Timing timing = measure(options, events.size(), [] { return Container(); }, [&events](Container& c) {
+    replay(c, events);
+  });
+  results.push_back(Result{ Ops<Container>::name(), type, "replay", events.size(), timing });
+}
+
+template <typename T>
+void benchType(const Options& options, const char* type, const std::vector<aisdi::TraceEvent>& events,
+               std::vector<Result>& results)
+{
+  benchContainer<aisdi::Vector<T>>(options, type, events, results);
+  benchContainer<aisdi::IncrementalVector<T>>(options, type, events, results);
+  benchContainer<std::vector<T>>(options, type, events, results);
+  benchContainer<std::deque<T>>(options, type, events, results);
+  benchContainer<aisdi::LinkedList<T>>(options, type, events, results);
+  benchContainer<aisdi::AdaptiveSequence<T>>(options, type, events, results);
+  benchContainer<aisdi::BTreeSequence<T>>(options, type, events, results);
+  benchContainer<std::list<T>>(options, type, events, results);
+}
+
+std::vector<aisdi::TraceEvent> loadTrace(const std::string& path)
+{
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if(fd < 0)
+    throw std::runtime_error("Cannot open " + path);
+  try {
+    aisdi::TraceReader reader(fd);
+    std::vector<aisdi::TraceEvent> events = reader.readAll();
+    ::close(fd);
+    aisdi::validateTrace(events);
+    return events;
+  }
+  catch(...) {
+    ::close(fd);
+    throw;
+  }
+}
+
+template <typename T, typename Results>
+void benchType(const Options& options, const char* type, Results& results)
+{
+  benchContainer<aisdi::Vector<T>>(options, type, results);
+  benchContainer<aisdi::IncrementalVector<T>>(options, type, results);
+  benchContainer<std::vector<T>>(options, type, results);
+  benchContainer<std::deque<T>>(options, type, results);
+  benchContainer<aisdi::LinkedList<T>>(options, type, results);
+  benchContainer<aisdi::AdaptiveSequence<T>>(options, type, results);
+  benchContainer<aisdi::BTreeSequence<T>>(options, type, results);
+  benchContainer<std::list<T>>(options, type, results);
+}
+
+template <typename Results>
+void benchTypes(const Options& options, Results& results)
+{
+  benchType<std::int32_t>(options, "int32", results);
+  benchType<std::uint64_t>(options, "uint64", results);
+  benchType<std::complex<std::int32_t>>(options, "complex<int32>", results);
+}
+
+void printUsage(const char* program)
+{
+  std::cerr << "usage: " << program << " [--mode time|latency|rss] [--sizes N,N,...] [--warmup N]\n"
+            << "         [--min-repetitions N] [--max-repetitions N] [--target-ops N]\n"
+            << "         [--max-quadratic N] [--counters on|off] [--batch N] [--histogram FILE]\n"
+            << "         [--buffer-cache BYTES] [--json FILE] [--csv FILE]\n"
+            << "Sizes accept scientific notation (1e8). FILE may be - for stdout.\n"
+            << "--counters on adds hardware counters per operation where perf allows it.\n"
+            << "--mode latency times every operation (or --batch of them) and reports\n"
+            << "  p50/p90/p99/p99.9/max; --histogram writes the full distribution as CSV.\n"
+            << "--mode rss reports resident memory growth per element (default size 1e6).\n"
+            << "--mode replay --trace FILE replays a trace written by aisdi::Recording\n"
+            << "  against every container and reports throughput.\n"
+            << "--buffer-cache BYTES lets freed buffers be reused through aisdi::BufferCache.\n";
+}
+
+std::size_t parseCount(const std::string& text)
+{
+  std::size_t used = 0;
+  double value = std::stod(text, &used);
+  if(used != text.size() || value < 0)
+    throw std::invalid_argument(text);
+  return static_cast<std::size_t>(value);
+}
+
+std::vector<std::size_t> parseSizes(const std::string& text)
+{
+  std::vector<std::size_t> sizes;
+  std::size_t begin = 0;
+  while(begin <= text.size()) {
+    std::size_t comma = text.find(',', begin);
+    if(comma == std::string::npos)
+      comma = text.size();
+    sizes.push_back(parseCount(text.substr(begin, comma - begin)));
+    begin = comma + 1;
+  }
+  return sizes;
+}
+
+template <typename Results, typename Writer>
+void writeTo(const std::string& path, const Results& results, Writer writer)
+{
+  if(path.empty())
+    return;
+  if(path == "-") {
+    writer(std::cout, results);
+    return;
+  }
+  std::ofstream file(path);
+  if(!file)
+    throw std::runtime_error("Cannot open " + path);
+  writer(file, results);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  Options options;
+  std::string jsonPath, csvPath, histogramPath, tracePath;
+  std::string mode = "time";
+  bool useCounters = false, sizesGiven = false;
+  try {
+    for(int i = 1; i < argc; ++i) {
+      std::string flag = argv[i];
+      if(i + 1 == argc)
+        throw std::invalid_argument(flag);
+      std::string value = argv[++i];
+      if(flag == "--mode" && (value == "time" || value == "latency" || value == "rss" || value == "replay"))
+        mode = value;
+      else if(flag == "--sizes") {
+        options.sizes = parseSizes(value);
+        sizesGiven = true;
+      }
+      else if(flag == "--warmup")
+        options.warmup = parseCount(value);
+      else if(flag == "--min-repetitions")
+        options.minRepetitions = parseCount(value);
+      else if(flag == "--max-repetitions")
+        options.maxRepetitions = parseCount(value);
+      else if(flag == "--target-ops")
+        options.targetOps = parseCount(value);
+      else if(flag == "--max-quadratic")
+        options.maxQuadraticSize = parseCount(value);
+      else if(flag == "--counters" && (value == "on" || value == "off"))
+        useCounters = value == "on";
+      else if(flag == "--batch")
+        options.latencyBatch = parseCount(value);
+      else if(flag == "--histogram")
+        histogramPath = value;
+      else if(flag == "--trace")
+        tracePath = value;
+      else if(flag == "--buffer-cache")
+        aisdi::BufferCache::local()->setCapacity(parseCount(value));
+      else if(flag == "--json")
+        jsonPath = value;
+      else if(flag == "--csv")
+        csvPath = value;
+      else
+        throw std::invalid_argument(flag);
+    }
+  }
+  catch(const std::logic_error&) {
+    printUsage(argv[0]);
+    return 1;
+  }
+  if(mode == "replay" && tracePath.empty()) {
+    printUsage(argv[0]);
+    return 1;
+  }
+  if(!options.minRepetitions)
+    options.minRepetitions = 1;
+
+  if(mode == "latency") {
+    if(!sizesGiven)
+      options.sizes = { 100000 };
+    std::vector<LatencyResult> results;
+    benchTypes(options, results);
+    aisdi::bench::printLatencyTable(std::cout, results);
+    writeTo(jsonPath, results, aisdi::bench::writeLatencyJson);
+    writeTo(csvPath, results, aisdi::bench::writeLatencyCsv);
+    writeTo(histogramPath, results, aisdi::bench::writeDistribution);
+    return 0;
+  }
+  if(mode == "replay") {
+    std::vector<aisdi::TraceEvent> events;
+    try {
+      events = loadTrace(tracePath);
+    }
+    catch(const std::exception& e) {
+      std::cerr << tracePath << ": " << e.what() << '\n';
+      return 1;
+    }
+    std::vector<Result> results;
+    benchType<std::int32_t>(options, "int32", events, results);
+    benchType<std::uint64_t>(options, "uint64", events, results);
+    benchType<std::complex<std::int32_t>>(options, "complex<int32>", events, results);
+    aisdi::bench::printThroughputTable(std::cout, results);
+    writeTo(jsonPath, results, aisdi::bench::writeJson);
+    writeTo(csvPath, results, aisdi::bench::writeCsv);
+    return 0;
+  }
+  if(mode == "rss") {
+    if(!sizesGiven)
+      options.sizes = { 1000000 };
+    std::vector<MemoryResult> results;
+    benchTypes(options, results);
+    aisdi::bench::printMemoryTable(std::cout, results);
+    writeTo(jsonPath, results, aisdi::bench::writeMemoryJson);
+    writeTo(csvPath, results, aisdi::bench::writeMemoryCsv);
+    return 0;
+  }
+
+  std::unique_ptr<aisdi::PerfCounters> counters;
+  if(useCounters) {
+    counters.reset(new aisdi::PerfCounters());
+    if(counters->isAvailable())
+      options.counters = counters.get();
+    else
+      std::cerr << "Hardware counters unavailable: " << counters->unavailableReason()
+                << "; reporting timings only\n";
+  }
+
+  std::vector<Result> results;
+  benchTypes(options, results);
+
+  aisdi::bench::printTable(std::cout, results);
+  writeTo(jsonPath, results, aisdi::bench::writeJson);
+  writeTo(csvPath, results, aisdi::bench::writeCsv);
+  return 0;
+}
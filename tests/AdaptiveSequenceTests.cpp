@@ -0,0 +1,169 @@
+#include <AdaptiveSequence.h>
+
+#include <initializer_list>
+#include <complex>
+#include <cstdint>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedTypes = boost::mpl::list<std::int32_t, std::uint64_t, std::complex<std::int32_t>>;
+
+template <typename T>
+using AdaptiveSequence = aisdi::AdaptiveSequence<T>;
+
+using std::begin;
+using std::end;
+
+namespace
+{
+
+template <typename T>
+void thenSequenceContainsValues(const AdaptiveSequence<T>& sequence, std::initializer_list<int> expected)
+{
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(sequence), end(sequence), begin(expected), end(expected));
+}
+
+template <typename T>
+bool isLinked(const AdaptiveSequence<T>& sequence)
+{
+  return sequence.representation() == AdaptiveSequence<T>::Representation::Linked;
+}
+
+template <typename T>
+void thenSequenceCountsDownFrom(const AdaptiveSequence<T>& sequence, int first)
+{
+  int expected = first;
+  for(const T& item : sequence)
+    BOOST_REQUIRE_EQUAL(item, T(expected--));
+  BOOST_CHECK_EQUAL(expected, -1);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(AdaptiveSequenceTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSequence_WhenEditedThroughCommonApi_ThenItBehavesLikeVector,
+                              T,
+                              TestedTypes)
+{
+  AdaptiveSequence<T> sequence = { 2, 3 };
+
+  sequence.prepend(T(1));
+  sequence.append(T(5));
+  sequence.insert(sequence.cbegin() + 3, T(4));
+  sequence.erase(sequence.cbegin());
+  *(sequence.begin() + 1) = T(30);
+
+  BOOST_CHECK_EQUAL(sequence.popLast(), T(5));
+  BOOST_CHECK_EQUAL(sequence.popFirst(), T(2));
+  thenSequenceContainsValues(sequence, { 30, 4 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenBulkAppends_ThenSequenceStaysContiguous,
+                              T,
+                              TestedTypes)
+{
+  AdaptiveSequence<T> sequence;
+
+  for(int i = 0; i < 10000; ++i)
+    sequence.append(T(i));
+
+  BOOST_CHECK(!isLinked(sequence));
+  BOOST_CHECK_EQUAL(sequence.getSize(), 10000u);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFrontEdits_WhenRepeated_ThenSequenceSwitchesToLinked,
+                              T,
+                              TestedTypes)
+{
+  AdaptiveSequence<T> sequence;
+
+  for(int i = 0; i < 1000; ++i)
+    sequence.prepend(T(i));
+
+  BOOST_CHECK(isLinked(sequence));
+  thenSequenceCountsDownFrom(sequence, 999);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLinkedSequence_WhenScannedRepeatedly_ThenItSwitchesBackToContiguous,
+                              T,
+                              TestedTypes)
+{
+  AdaptiveSequence<T> sequence;
+  for(int i = 0; i < 1000; ++i)
+    sequence.prepend(T(i));
+  BOOST_REQUIRE(isLinked(sequence));
+
+  for(int pass = 0; pass < 100 && isLinked(sequence); ++pass) {
+    T total = T();
+    for(const T& item : sequence)
+      total += item;
+    sequence.append(sequence.popLast());
+  }
+
+  BOOST_CHECK(!isLinked(sequence));
+  thenSequenceCountsDownFrom(sequence, 999);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIteratorBeforeConversion_WhenUsedAfterIt_ThenExceptionIsThrown,
+                              T,
+                              TestedTypes)
+{
+  AdaptiveSequence<T> sequence = { 1, 2, 3 };
+  auto position = sequence.cbegin() + 1;
+
+  sequence.convertTo(AdaptiveSequence<T>::Representation::Linked);
+
+  BOOST_CHECK_THROW(sequence.insert(position, T(0)), std::logic_error);
+  BOOST_CHECK_THROW(*position, std::logic_error);
+  sequence.insert(sequence.cbegin() + 1, T(0));
+  thenSequenceContainsValues(sequence, { 1, 0, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLinkedSequence_WhenErasingRange_ThenItemsAreRemoved,
+                              T,
+                              TestedTypes)
+{
+  AdaptiveSequence<T> sequence = { 1, 2, 3, 4, 9 };
+  sequence.convertTo(AdaptiveSequence<T>::Representation::Linked);
+
+  sequence.erase(sequence.cbegin() + 1, sequence.cend() - 1);
+  *(sequence.end() - 1) = T(4);
+
+  thenSequenceContainsValues(sequence, { 1, 4 });
+  BOOST_CHECK_EQUAL(sequence.getSize(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptySequence_WhenPoppingOrErasing_ThenExceptionIsThrown,
+                              T,
+                              TestedTypes)
+{
+  AdaptiveSequence<T> sequence;
+
+  BOOST_CHECK_THROW(sequence.popFirst(), std::logic_error);
+  BOOST_CHECK_THROW(sequence.popLast(), std::logic_error);
+  BOOST_CHECK_THROW(sequence.erase(sequence.cbegin()), std::out_of_range);
+  BOOST_CHECK_THROW(*sequence.cend(), std::out_of_range);
+  BOOST_CHECK_THROW(sequence.cbegin() - 1, std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSequenceOfBools_WhenConvertingBothWays_ThenFlagsAreKept)
+{
+  AdaptiveSequence<bool> sequence = { true, false, true };
+
+  *(sequence.begin() + 1) = true;
+  sequence.convertTo(AdaptiveSequence<bool>::Representation::Linked);
+  sequence.append(false);
+  sequence.convertTo(AdaptiveSequence<bool>::Representation::Contiguous);
+
+  BOOST_CHECK_EQUAL(sequence.getSize(), 4u);
+  BOOST_CHECK(*sequence.cbegin());
+  BOOST_CHECK(*(sequence.cbegin() + 1));
+  BOOST_CHECK(!sequence.popLast());
+  BOOST_CHECK(sequence.popFirst());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,214 @@
+#include <BTreeSequence.h>
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedTypes = boost::mpl::list<std::int32_t, std::uint64_t, std::complex<std::int32_t>>;
+
+template <typename T>
+using BTreeSequence = aisdi::BTreeSequence<T>;
+
+namespace
+{
+
+template <typename T>
+void appendRange(BTreeSequence<T>& sequence, int from, int to)
+{
+  for(int i = from; i < to; ++i)
+    sequence.append(T(i));
+}
+
+// Checks both at() and a forward and backward pass over the linked leaves.
+template <typename T>
+void thenSequenceMatches(const BTreeSequence<T>& sequence, const std::vector<int>& expected)
+{
+  BOOST_REQUIRE_EQUAL(sequence.getSize(), expected.size());
+  for(std::size_t i = 0; i < expected.size(); ++i)
+    BOOST_REQUIRE_EQUAL(sequence.at(i), T(expected[i]));
+  std::size_t i = 0;
+  for(auto it = sequence.begin(); it != sequence.end(); ++it, ++i)
+    BOOST_REQUIRE_EQUAL(*it, T(expected[i]));
+  BOOST_REQUIRE_EQUAL(i, expected.size());
+  for(auto it = sequence.end(); it != sequence.begin();)
+    BOOST_REQUIRE_EQUAL(*--it, T(expected[--i]));
+}
+
+std::vector<int> range(int from, int to)
+{
+  std::vector<int> result;
+  for(int i = from; i < to; ++i)
+    result.push_back(i);
+  return result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(BTreeSequenceTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptySequence_ThenBeginEqualsEnd,
+                              T,
+                              TestedTypes)
+{
+  const BTreeSequence<T> sequence;
+
+  BOOST_CHECK(sequence.isEmpty());
+  BOOST_CHECK_EQUAL(sequence.getHeight(), std::size_t(0));
+  BOOST_CHECK(sequence.begin() == sequence.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenManyAppends_WhenIterating_ThenItemsAreInOrder,
+                              T,
+                              TestedTypes)
+{
+  BTreeSequence<T> sequence;
+
+  appendRange(sequence, 0, 20000);
+
+  BOOST_CHECK_GE(sequence.getHeight(), std::size_t(2));
+  thenSequenceMatches(sequence, range(0, 20000));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSequence_WhenInsertingAndErasingAtRandom_ThenItMatchesVector,
+                              T,
+                              TestedTypes)
+{
+  BTreeSequence<T> sequence;
+  std::vector<int> expected;
+  std::mt19937 random(44);
+
+  for(int step = 0; step < 30000; ++step) {
+    bool grow = expected.size() < 500 || random() % 5 < 3;
+    if(grow) {
+      std::size_t index = random() % (expected.size() + 1);
+      sequence.insert(index, T(step));
+      expected.insert(expected.begin() + index, step);
+    }
+    else {
+      std::size_t index = random() % expected.size();
+      BOOST_REQUIRE_EQUAL(sequence.erase(index), T(expected[index]));
+      expected.erase(expected.begin() + index);
+    }
+  }
+  thenSequenceMatches(sequence, expected);
+
+  while(!expected.empty()) {
+    std::size_t index = random() % expected.size();
+    sequence.erase(index);
+    expected.erase(expected.begin() + index);
+  }
+  BOOST_CHECK(sequence.isEmpty());
+  BOOST_CHECK_EQUAL(sequence.getHeight(), std::size_t(0));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSequencesOfDifferentHeights_WhenConcatenating_ThenItemsFollowEachOther,
+                              T,
+                              TestedTypes)
+{
+  const int sizes[] = {1, 5, 300, 7000};
+  for(int leftSize : sizes)
+    for(int rightSize : sizes) {
+      BTreeSequence<T> left, right;
+      appendRange(left, 0, leftSize);
+      appendRange(right, leftSize, leftSize + rightSize);
+
+      left.concat(std::move(right));
+
+      BOOST_CHECK(right.isEmpty());
+      thenSequenceMatches(left, range(0, leftSize + rightSize));
+      left.insert(leftSize, T(-1));
+      BOOST_CHECK_EQUAL(left.erase(leftSize), T(-1));
+      BOOST_CHECK_EQUAL(left.popLast(), T(leftSize + rightSize - 1));
+    }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSequence_WhenSplitting_ThenBothHalvesKeepTheirItems,
+                              T,
+                              TestedTypes)
+{
+  const int size = 5000;
+  const int positions[] = {0, 1, 63, 64, 128, 2500, 4096, size - 1, size};
+  for(int position : positions) {
+    BTreeSequence<T> sequence;
+    appendRange(sequence, 0, size);
+
+    BTreeSequence<T> tail = sequence.split(position);
+
+    thenSequenceMatches(sequence, range(0, position));
+    thenSequenceMatches(tail, range(position, size));
+    sequence.concat(std::move(tail));
+    thenSequenceMatches(sequence, range(0, size));
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSequence_WhenErasingRange_ThenRemainingItemsAreJoined,
+                              T,
+                              TestedTypes)
+{
+  BTreeSequence<T> sequence;
+  appendRange(sequence, 0, 3000);
+
+  sequence.erase(sequence.cbegin() + 100, sequence.cbegin() + 2900);
+
+  std::vector<int> expected = range(0, 100);
+  std::vector<int> tail = range(2900, 3000);
+  expected.insert(expected.end(), tail.begin(), tail.end());
+  thenSequenceMatches(sequence, expected);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSequence_WhenWritingThroughIterator_ThenItemIsChanged,
+                              T,
+                              TestedTypes)
+{
+  BTreeSequence<T> sequence;
+  appendRange(sequence, 0, 1000);
+
+  *(sequence.begin() + 700) = T(-7);
+  sequence.at(3) = T(-3);
+
+  BOOST_CHECK_EQUAL(sequence.at(700), T(-7));
+  BOOST_CHECK_EQUAL(*(sequence.cend() - 997), T(-3));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSequence_WhenCopyingAndMoving_ThenItemsAreKept,
+                              T,
+                              TestedTypes)
+{
+  BTreeSequence<T> sequence;
+  appendRange(sequence, 0, 2000);
+
+  BTreeSequence<T> copy = sequence;
+  BTreeSequence<T> moved = std::move(sequence);
+  copy.prepend(T(-1));
+
+  BOOST_CHECK(sequence.isEmpty());
+  thenSequenceMatches(moved, range(0, 2000));
+  thenSequenceMatches(copy, range(-1, 2000));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptySequence_WhenAccessingOutOfRange_ThenExceptionIsThrown,
+                              T,
+                              TestedTypes)
+{
+  BTreeSequence<T> sequence;
+
+  BOOST_CHECK_THROW(sequence.popFirst(), std::logic_error);
+  BOOST_CHECK_THROW(sequence.popLast(), std::logic_error);
+  BOOST_CHECK_THROW(sequence.erase(sequence.cbegin()), std::out_of_range);
+  BOOST_CHECK_THROW(sequence.at(0), std::out_of_range);
+  BOOST_CHECK_THROW(sequence.insert(1, T(0)), std::out_of_range);
+  BOOST_CHECK_THROW(sequence.split(1), std::out_of_range);
+  BOOST_CHECK_THROW(*sequence.cend(), std::out_of_range);
+  BOOST_CHECK_THROW(sequence.cbegin() - 1, std::out_of_range);
+  BOOST_CHECK_THROW(sequence.concat(std::move(sequence)), std::logic_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,126 @@
+#include <BufferCache.h>
+#include <Vector.h>
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedTypes = boost::mpl::list<std::int32_t, std::uint64_t, std::complex<std::int32_t>>;
+
+namespace
+{
+
+// The cache is per thread and shared by all tests, so each test enables it
+// and leaves it empty and off again.
+struct EnabledCache
+{
+  explicit EnabledCache(std::size_t bytes = 1 << 20) : cache(*aisdi::BufferCache::local()) {
+    cache.setCapacity(bytes);
+  }
+
+  ~EnabledCache() {
+    cache.setCapacity(0);
+  }
+
+  aisdi::BufferCache& cache;
+};
+
+template <typename T>
+void buildAndDrop(int count)
+{
+  aisdi::Vector<T> vector;
+  for(int i = 0; i < count; ++i)
+    vector.append(T(i));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(BufferCacheTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenDisabledCache_WhenDroppingVectors_ThenNothingIsCached,
+                              T,
+                              TestedTypes)
+{
+  aisdi::BufferCache& cache = *aisdi::BufferCache::local();
+  std::uint64_t hits = cache.hits();
+
+  buildAndDrop<T>(1000);
+  buildAndDrop<T>(1000);
+
+  BOOST_CHECK_EQUAL(cache.getCapacity(), 0u);
+  BOOST_CHECK_EQUAL(cache.cachedBytes(), 0u);
+  BOOST_CHECK_EQUAL(cache.hits(), hits);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEnabledCache_WhenRepeatingSameWorkload_ThenEveryBufferIsReused,
+                              T,
+                              TestedTypes)
+{
+  EnabledCache enabled;
+  buildAndDrop<T>(1000);
+  std::uint64_t misses = enabled.cache.misses();
+  std::uint64_t hits = enabled.cache.hits();
+
+  buildAndDrop<T>(1000);
+
+  BOOST_CHECK_EQUAL(enabled.cache.misses(), misses);
+  BOOST_CHECK_GT(enabled.cache.hits(), hits);
+  BOOST_CHECK_GT(enabled.cache.cachedBytes(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSmallBudget_WhenDroppingLargeVector_ThenCacheStaysWithinBudget,
+                              T,
+                              TestedTypes)
+{
+  EnabledCache enabled(4096);
+
+  buildAndDrop<T>(10000);
+
+  BOOST_CHECK_LE(enabled.cache.cachedBytes(), 4096u);
+  BOOST_CHECK_GT(enabled.cache.cachedBytes(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFilledCache_WhenTrimming_ThenLargestBuffersAreFreedFirst,
+                              T,
+                              TestedTypes)
+{
+  EnabledCache enabled;
+  {
+    aisdi::Vector<T> small = { T(1) };
+    aisdi::Vector<T> large;
+    large.reserve(1000);
+  }
+  std::size_t smallBytes = (START_SIZE + 1) * sizeof(T);
+
+  enabled.cache.trim(smallBytes);
+
+  BOOST_CHECK_EQUAL(enabled.cache.cachedBytes(), smallBytes);
+  enabled.cache.trim();
+  BOOST_CHECK_EQUAL(enabled.cache.cachedBytes(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenDefaultCapacity_WhenStartingThread_ThenItsCacheUsesIt)
+{
+  std::size_t threadCapacity = 0, threadCached = 0;
+  aisdi::BufferCache::setDefaultCapacity(8192);
+
+  std::thread worker([&] {
+    buildAndDrop<std::int32_t>(100);
+    threadCapacity = aisdi::BufferCache::local()->getCapacity();
+    threadCached = aisdi::BufferCache::local()->cachedBytes();
+  });
+  worker.join();
+  aisdi::BufferCache::setDefaultCapacity(0);
+
+  BOOST_CHECK_EQUAL(threadCapacity, 8192u);
+  BOOST_CHECK_GT(threadCached, 0u);
+  BOOST_CHECK_EQUAL(aisdi::BufferCache::local()->getCapacity(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,247 @@
+#include <CompressedIntVector.h>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/mpl/list.hpp>
+
+namespace
+{
+
+template <typename T>
+using CompressedVector = aisdi::CompressedIntVector<T>;
+
+using TestedTypes = boost::mpl::list<std::int32_t, std::uint32_t, std::uint64_t>;
+
+const std::size_t BLOCK = 128;
+
+template <typename T>
+std::vector<T> givenMixedValues(std::size_t count)
+{
+  std::vector<T> values;
+  std::uint64_t state = 88172645463325252ull;
+  for(std::size_t i = 0; i < count; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    // Every few blocks the spread, and so the packed width, changes.
+    unsigned bits = (i / BLOCK) % (std::numeric_limits<T>::digits + 1);
+    std::uint64_t mask = bits >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bits) - 1;
+    values.push_back(static_cast<T>(state & mask));
+  }
+  return values;
+}
+
+template <typename T>
+CompressedVector<T> givenCompressed(const std::vector<T>& values)
+{
+  CompressedVector<T> compressed;
+  for(auto value : values)
+    compressed.append(value);
+  return compressed;
+}
+
+template <typename T>
+void thenContainsExactly(const CompressedVector<T>& compressed, const std::vector<T>& expected)
+{
+  BOOST_REQUIRE_EQUAL(compressed.getSize(), expected.size());
+  std::size_t i = 0;
+  for(auto it = compressed.begin(); it != compressed.end(); ++it, ++i)
+    BOOST_REQUIRE_EQUAL(*it, expected[i]);
+  for(i = 0; i < expected.size(); ++i)
+    BOOST_REQUIRE_EQUAL(compressed.at(i), expected[i]);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(CompressedIntVectorTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVector_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              T, TestedTypes)
+{
+  const CompressedVector<T> compressed;
+
+  BOOST_CHECK(compressed.isEmpty());
+  BOOST_CHECK_EQUAL(compressed.blockCount(), 0);
+  BOOST_CHECK(compressed.begin() == compressed.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVector_WhenCreatedWithInitializerList_ThenItHoldsTheValues,
+                              T, TestedTypes)
+{
+  const CompressedVector<T> compressed = { 3, 1, 4, 1, 5 };
+
+  thenContainsExactly(compressed, std::vector<T>{ 3, 1, 4, 1, 5 });
+  BOOST_CHECK_EQUAL(compressed.blockCount(), 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenBlocksOfEveryWidth_WhenReading_ThenValuesRoundTrip,
+                              T, TestedTypes)
+{
+  auto values = givenMixedValues<T>(BLOCK * (std::numeric_limits<T>::digits + 2) + 17);
+
+  auto compressed = givenCompressed(values);
+
+  thenContainsExactly(compressed, values);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSortedIds_WhenAppending_ThenTheyTakeAFractionOfTheSpace,
+                              T, TestedTypes)
+{
+  std::vector<T> values;
+  T id = 1000;
+  for(std::size_t i = 0; i < 64 * BLOCK; ++i)
+    values.push_back(id += static_cast<T>(1 + (i * 7919) % 200));
+
+  auto compressed = givenCompressed(values);
+
+  thenContainsExactly(compressed, values);
+  BOOST_CHECK_LT(compressed.compressedBytes() * 3, values.size() * sizeof(T));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenConstantBlock_WhenReading_ThenItNeedsNoPackedWords,
+                              T, TestedTypes)
+{
+  std::vector<T> values(3 * BLOCK, 42);
+
+  auto compressed = givenCompressed(values);
+
+  thenContainsExactly(compressed, values);
+  BOOST_CHECK_LT(compressed.compressedBytes(), sizeof(T) * BLOCK + 256);
+}
+
+BOOST_AUTO_TEST_CASE(GivenNegativeValues_WhenReading_ThenTheyAreRestored)
+{
+  std::vector<std::int64_t> values;
+  for(std::int64_t i = 0; i < static_cast<std::int64_t>(2 * BLOCK); ++i)
+    values.push_back(i % 2 ? -i : i - 100);
+  values.push_back(std::numeric_limits<std::int64_t>::min());
+  for(std::size_t i = 0; i < BLOCK; ++i)
+    values.push_back(std::numeric_limits<std::int64_t>::max() - static_cast<std::int64_t>(i % 3));
+
+  auto compressed = givenCompressed(values);
+
+  thenContainsExactly(compressed, values);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVector_WhenDecodingBlocks_ThenEachBlockIsReturnedWithItsLength,
+                              T, TestedTypes)
+{
+  auto values = givenMixedValues<T>(2 * BLOCK + 5);
+  auto compressed = givenCompressed(values);
+  T out[BLOCK];
+
+  BOOST_REQUIRE_EQUAL(compressed.blockCount(), 3);
+  BOOST_CHECK_EQUAL(compressed.decodeBlock(1, out), BLOCK);
+  BOOST_CHECK_EQUAL_COLLECTIONS(out, out + BLOCK, values.begin() + BLOCK, values.begin() + 2 * BLOCK);
+  BOOST_CHECK_EQUAL(compressed.decodeBlock(2, out), 5);
+  BOOST_CHECK_EQUAL_COLLECTIONS(out, out + 5, values.begin() + 2 * BLOCK, values.end());
+  BOOST_CHECK_THROW(compressed.decodeBlock(3, out), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFullBlocks_WhenPoppingLast_ThenLastBlockIsUnpackedAgain,
+                              T, TestedTypes)
+{
+  auto values = givenMixedValues<T>(2 * BLOCK + 1);
+  auto compressed = givenCompressed(values);
+
+  for(std::size_t i = 0; i < BLOCK + 2; ++i) {
+    BOOST_CHECK_EQUAL(compressed.popLast(), values.back());
+    values.pop_back();
+  }
+  compressed.append(7);
+  values.push_back(7);
+
+  thenContainsExactly(compressed, values);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIteratorIntoTail_WhenTailChanges_ThenIteratorSeesNewValue,
+                              T, TestedTypes)
+{
+  CompressedVector<T> compressed;
+  compressed.append(1);
+  auto it = compressed.begin();
+  BOOST_CHECK_EQUAL(*it, T(1));
+
+  compressed.popLast();
+  compressed.append(99);
+  BOOST_CHECK_EQUAL(*it, T(99));
+
+  for(std::size_t i = 1; i < BLOCK - 1; ++i)
+    compressed.append(T(i));
+  BOOST_CHECK_EQUAL(*(it + (BLOCK - 2)), T(BLOCK - 2));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIteratorIntoSealedBlock_WhenBlockIsUnsealedAndRefilled_ThenIteratorSeesNewValues,
+                              T, TestedTypes)
+{
+  auto values = givenMixedValues<T>(BLOCK);
+  auto compressed = givenCompressed(values);
+  auto it = compressed.begin();
+  BOOST_CHECK_EQUAL(*it, values[0]);
+
+  std::vector<T> refilled(BLOCK, T(5));
+  for(std::size_t i = 0; i < BLOCK; ++i)
+    compressed.popLast();
+  for(const T& value : refilled)
+    compressed.append(value);
+  compressed.append(T(6));
+
+  BOOST_CHECK_EQUAL(*it, T(5));
+  BOOST_CHECK_EQUAL(*(it + (BLOCK - 1)), T(5));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyVector_WhenPoppingLast_ThenExceptionIsThrown,
+                              T, TestedTypes)
+{
+  CompressedVector<T> compressed;
+
+  BOOST_CHECK_THROW(compressed.popLast(), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVector_WhenAccessingPastTheEnd_ThenExceptionIsThrown,
+                              T, TestedTypes)
+{
+  const CompressedVector<T> compressed = { 1, 2, 3 };
+
+  BOOST_CHECK_THROW(compressed.at(3), std::out_of_range);
+  BOOST_CHECK_THROW(*compressed.end(), std::out_of_range);
+  BOOST_CHECK_THROW(compressed.end()++, std::out_of_range);
+  BOOST_CHECK_THROW(compressed.begin()--, std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenWalkingBackwards_ThenValuesComeInReverse,
+                              T, TestedTypes)
+{
+  auto values = givenMixedValues<T>(3 * BLOCK);
+  auto compressed = givenCompressed(values);
+
+  auto it = compressed.end();
+  for(std::size_t i = values.size(); i-- > 0;)
+    BOOST_REQUIRE_EQUAL(*--it, values[i]);
+  BOOST_CHECK(it == compressed.begin());
+  BOOST_CHECK_EQUAL(*(it + BLOCK + 1), values[BLOCK + 1]);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVector_WhenMoved_ThenSourceIsEmptyAndUsable,
+                              T, TestedTypes)
+{
+  auto values = givenMixedValues<T>(BLOCK + 9);
+  auto source = givenCompressed(values);
+  auto copy = source;
+
+  CompressedVector<T> moved = std::move(source);
+  source.append(5);
+  CompressedVector<T> assigned;
+  assigned = std::move(copy);
+
+  thenContainsExactly(moved, values);
+  thenContainsExactly(assigned, values);
+  thenContainsExactly(source, std::vector<T>{ 5 });
+  BOOST_CHECK(copy.isEmpty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,201 @@
+#include <LinkedList.h>
+#include <Vector.h>
+
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+using aisdi::CountingStats;
+using aisdi::StatsCounters;
+using aisdi::StatsRegistry;
+
+using CountedVector = aisdi::Vector<int, 64, CountingStats>;
+using CountedList = aisdi::LinkedList<int, CountingStats>;
+
+BOOST_AUTO_TEST_SUITE(ContainerStatsTests)
+
+BOOST_AUTO_TEST_CASE(GivenDefaultPolicy_ThenContainersCarryNoStatsState)
+{
+  static_assert(std::is_empty<aisdi::NoStats>::value, "NoStats must stay empty");
+  BOOST_CHECK_EQUAL(sizeof(aisdi::LinkedList<int>), 2 * sizeof(void*) + sizeof(std::size_t));
+  BOOST_CHECK_EQUAL(aisdi::Vector<int>().stats().counters().allocations, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCountedVector_WhenGrowingPastStartSize_ThenReallocationIsCounted)
+{
+  CountedVector vector;
+
+  for(int i = 0; i < 11; ++i)
+    vector.append(i);
+
+  const StatsCounters& c = vector.stats().counters();
+  BOOST_CHECK_EQUAL(c.allocations, 2u);
+  BOOST_CHECK_EQUAL(c.frees, 1u);
+  BOOST_CHECK_EQUAL(c.reallocations, 1u);
+  BOOST_CHECK_EQUAL(c.elementsCopied, 10u);
+  BOOST_CHECK_EQUAL(c.bytesCopied, 10 * sizeof(int));
+  BOOST_CHECK_EQUAL(c.peakCapacity, 20u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCountedVector_WhenShifting_ThenMovedElementsAreCounted)
+{
+  CountedVector vector = { 1, 2, 3, 4 };
+  std::uint64_t before = vector.stats().counters().elementsCopied;
+
+  vector.prepend(0);
+  vector.erase(vector.cbegin() + 1);
+
+  BOOST_CHECK_EQUAL(vector.stats().counters().elementsCopied - before, 4u + 3u);
+  BOOST_CHECK_EQUAL(vector.stats().counters().reallocations, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCountedList_WhenAddingAndRemoving_ThenLiveNodesAreTracked)
+{
+  CountedList list;
+
+  for(int i = 0; i < 5; ++i)
+    list.append(i);
+  list.popFirst();
+  list.erase(list.cbegin());
+
+  const StatsCounters& c = list.stats().counters();
+  BOOST_CHECK_EQUAL(c.nodeAllocations, 5u);
+  BOOST_CHECK_EQUAL(c.nodeFrees, 2u);
+  BOOST_CHECK_EQUAL(c.liveNodes, 3);
+  BOOST_CHECK_EQUAL(c.peakLiveNodes, 5);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCountedList_WhenMoved_ThenLiveNodesFollowTheNodes)
+{
+  CountedList source = { 1, 2, 3 };
+
+  CountedList target = std::move(source);
+
+  BOOST_CHECK_EQUAL(source.stats().counters().liveNodes, 0);
+  BOOST_CHECK_EQUAL(target.stats().counters().liveNodes, 3);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCountedList_WhenCopyAssigned_ThenExistingNodesAreReused)
+{
+  CountedList target = { 9, 9, 9 };
+  const CountedList longer = { 1, 2, 3, 4, 5 };
+  const CountedList shorter = { 6, 7 };
+
+  target = longer;
+  BOOST_CHECK_EQUAL(target.stats().counters().nodeAllocations, 3u + 2u);
+  BOOST_CHECK_EQUAL(target.stats().counters().nodeFrees, 0u);
+
+  target = shorter;
+  BOOST_CHECK_EQUAL(target.stats().counters().nodeAllocations, 5u);
+  BOOST_CHECK_EQUAL(target.stats().counters().nodeFrees, 3u);
+  BOOST_CHECK_EQUAL(target.stats().counters().liveNodes, 2);
+  BOOST_CHECK_EQUAL(*target.cbegin(), 6);
+  BOOST_CHECK_EQUAL(*++target.cbegin(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCountedVector_WhenCopyAssigned_ThenAtMostOneBufferIsAllocated)
+{
+  CountedVector target;
+  const CountedVector small = { 1, 2, 3 };
+  CountedVector large;
+  for(int i = 0; i < 1000; ++i)
+    large.append(i);
+
+  target = large;
+  BOOST_CHECK_EQUAL(target.stats().counters().allocations, 2u);
+  BOOST_CHECK_EQUAL(target.stats().counters().elementsCopied, 0u);
+
+  target = small;
+  BOOST_CHECK_EQUAL(target.getSize(), 3u);
+  target = large;
+  BOOST_CHECK_EQUAL(target.stats().counters().allocations, 2u);
+  BOOST_REQUIRE_EQUAL(target.getSize(), 1000u);
+  BOOST_CHECK_EQUAL(*(target.cbegin() + 999), 999);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCountedContainers_WhenUsed_ThenRegistryAggregatesTheirEvents)
+{
+  StatsCounters before = StatsRegistry::global().snapshot();
+  {
+    CountedVector vector;
+    for(int i = 0; i < 25; ++i)
+      vector.append(i);
+    CountedList list = { 1, 2 };
+  }
+  StatsCounters after = StatsRegistry::global().snapshot();
+
+  BOOST_CHECK_EQUAL(after.reallocations - before.reallocations, 2u);
+  BOOST_CHECK_EQUAL(after.allocations - after.frees, before.allocations - before.frees);
+  BOOST_CHECK_EQUAL(after.nodeAllocations - before.nodeAllocations, 2u);
+  BOOST_CHECK_EQUAL(after.liveNodes, before.liveNodes);
+  BOOST_CHECK_GE(after.peakCapacity, 40u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenRegistry_WhenDumped_ThenJsonListsEveryCounter)
+{
+  std::ostringstream out;
+
+  StatsRegistry::global().dumpJson(out);
+
+  std::string json = out.str();
+  BOOST_CHECK_EQUAL(json.front(), '{');
+  BOOST_CHECK_EQUAL(json.back(), '}');
+  for(const char* key : { "\"allocations\"", "\"reallocations\"", "\"bytes_copied\"",
+                          "\"peak_capacity\"", "\"live_nodes\"", "\"peak_live_nodes\"" })
+    BOOST_CHECK(json.find(key) != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(GivenVectorWithThreeElements_WhenAskedForMemoryUsage_ThenSlackCoversTheRestOfTheBuffer)
+{
+  aisdi::Vector<int> vector = { 1, 2, 3 };
+
+  aisdi::MemoryUsage usage = vector.memoryUsage();
+
+  BOOST_CHECK_EQUAL(usage.usedBytes, 3 * sizeof(int));
+  BOOST_CHECK_EQUAL(usage.usedBytes + usage.slackBytes, (START_SIZE + 1) * sizeof(int));
+  BOOST_CHECK_EQUAL(usage.overheadBytes, sizeof(vector));
+  BOOST_CHECK_EQUAL(usage.perNodeOverhead, 0u);
+  BOOST_CHECK_EQUAL(usage.allocations, 1u);
+  BOOST_CHECK_GT(usage.allocatorBytes, 0u);
+  BOOST_CHECK_EQUAL(usage.totalBytes(), usage.usedBytes + usage.slackBytes + usage.overheadBytes
+                                            + usage.allocatorBytes);
+}
+
+BOOST_AUTO_TEST_CASE(GivenListWithThreeElements_WhenAskedForMemoryUsage_ThenNodesAndSentinelsAreCounted)
+{
+  aisdi::LinkedList<int> list = { 1, 2, 3 };
+
+  aisdi::MemoryUsage usage = list.memoryUsage();
+
+  BOOST_CHECK_EQUAL(usage.usedBytes, 3 * sizeof(int));
+  BOOST_CHECK_EQUAL(usage.slackBytes, 0u);
+  BOOST_CHECK_GE(usage.perNodeOverhead, 2 * sizeof(void*));
+  BOOST_CHECK_EQUAL(usage.overheadBytes, sizeof(list) + 2 * 2 * sizeof(void*) + 3 * usage.perNodeOverhead);
+  BOOST_CHECK_EQUAL(usage.allocations, 5u);
+  BOOST_CHECK_GE(usage.allocatorBytes, 5 * sizeof(std::size_t));
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptyList_WhenAskedForMemoryUsage_ThenOnlySentinelsRemain)
+{
+  aisdi::LinkedList<int> list;
+
+  aisdi::MemoryUsage usage = list.memoryUsage();
+
+  BOOST_CHECK_EQUAL(usage.usedBytes, 0u);
+  BOOST_CHECK_EQUAL(usage.allocations, 2u);
+  BOOST_CHECK_EQUAL(usage.overheadBytes, sizeof(list) + 2 * 2 * sizeof(void*));
+}
+
+BOOST_AUTO_TEST_CASE(GivenSmallBlock_WhenEstimatingAllocatorOverhead_ThenMinimumChunkIsUsed)
+{
+  BOOST_CHECK_EQUAL(aisdi::detail::allocationOverhead(1), 31u);
+  BOOST_CHECK_EQUAL(aisdi::detail::allocationOverhead(24), 8u);
+  BOOST_CHECK_EQUAL(aisdi::detail::allocationOverhead(40), 8u);
+  BOOST_CHECK_EQUAL(aisdi::detail::allocationOverhead(std::size_t(3) << 20, true), std::size_t(1) << 20);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
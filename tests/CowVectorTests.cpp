@@ -0,0 +1,195 @@
+#include <CowVector.h>
+
+#include <initializer_list>
+#include <complex>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedTypes = boost::mpl::list<std::int32_t, std::uint64_t, std::complex<std::int32_t>>;
+
+template <typename T>
+using CowVector = aisdi::CowVector<T>;
+
+using std::begin;
+using std::end;
+
+BOOST_AUTO_TEST_SUITE(CowVectorTests)
+
+template <typename T>
+void thenVectorContainsValues(const CowVector<T>& vector, std::initializer_list<int> expected)
+{
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(vector), end(vector), begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVector_WhenCopying_ThenBufferIsShared,
+                              T,
+                              TestedTypes)
+{
+  const CowVector<T> vector = { 1, 2, 3 };
+
+  const CowVector<T> copy = vector;
+
+  BOOST_CHECK(vector.isShared());
+  BOOST_CHECK(copy.data() == vector.data());
+  thenVectorContainsValues(copy, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSharedVector_WhenAppending_ThenOnlyWriterChanges,
+                              T,
+                              TestedTypes)
+{
+  const CowVector<T> vector = { 1, 2 };
+  CowVector<T> copy = vector;
+
+  copy.append(T(3));
+
+  BOOST_CHECK(!vector.isShared());
+  BOOST_CHECK(!copy.isShared());
+  thenVectorContainsValues(vector, { 1, 2 });
+  thenVectorContainsValues(copy, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSharedVector_WhenInsertingAtPositionFromSharedBuffer_ThenPositionIsKept,
+                              T,
+                              TestedTypes)
+{
+  const CowVector<T> vector = { 1, 2, 3 };
+  CowVector<T> copy = vector;
+
+  copy.insert(copy.cbegin() + 1, T(9));
+  copy.erase(copy.cbegin() + 3);
+
+  thenVectorContainsValues(vector, { 1, 2, 3 });
+  thenVectorContainsValues(copy, { 1, 9, 2 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSharedVector_WhenWritingThroughIterator_ThenOtherCopyIsUnchanged,
+                              T,
+                              TestedTypes)
+{
+  const CowVector<T> vector = { 1, 2, 3 };
+  CowVector<T> copy = vector;
+
+  *copy.begin() = T(7);
+
+  thenVectorContainsValues(vector, { 1, 2, 3 });
+  thenVectorContainsValues(copy, { 7, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMutableIterator_WhenCopyingAfterwards_ThenWritesDoNotReachTheCopy,
+                              T,
+                              TestedTypes)
+{
+  CowVector<T> vector = { 1, 2, 3 };
+  auto it = vector.begin();
+  T* raw = vector.data();
+
+  CowVector<T> copy = vector;
+  CowVector<T> assigned;
+  assigned = vector;
+  *it = T(7);
+  raw[2] = T(9);
+
+  BOOST_CHECK(!copy.isShared());
+  BOOST_CHECK(!vector.isShared());
+  thenVectorContainsValues(vector, { 7, 2, 9 });
+  thenVectorContainsValues(copy, { 1, 2, 3 });
+  thenVectorContainsValues(assigned, { 1, 2, 3 });
+  CowVector<T> second = copy;
+  BOOST_CHECK(copy.isShared());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMutableIteration_WhenVectorGrowsAndIsCopied_ThenItStaysUnshareable,
+                              T,
+                              TestedTypes)
+{
+  CowVector<T> vector = { 1, 2, 3 };
+  auto it = vector.begin();
+  for(int i = 0; i < 100; ++i)
+    vector.append(T(i));
+
+  CowVector<T> copy = vector;
+  *it = T(7);
+
+  BOOST_CHECK(!vector.isShared());
+  BOOST_CHECK_EQUAL(*copy.cbegin(), T(1));
+  BOOST_CHECK_EQUAL(*vector.cbegin(), T(7));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterationThroughView_WhenCopying_ThenBufferIsShared,
+                              T,
+                              TestedTypes)
+{
+  CowVector<T> vector = { 1, 2, 3 };
+  T total = T();
+  for(const T& item : vector.view())
+    total += item;
+
+  CowVector<T> copy = vector;
+
+  BOOST_CHECK_EQUAL(total, T(6));
+  BOOST_CHECK(vector.isShared());
+  BOOST_CHECK(copy.view().data() == vector.view().data());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSharedVector_WhenErasingRangeAndPopping_ThenOtherCopyIsUnchanged,
+                              T,
+                              TestedTypes)
+{
+  CowVector<T> vector = { 1, 2, 3, 4, 5 };
+  CowVector<T> copy;
+  copy = vector;
+
+  copy.erase(copy.cbegin() + 1, copy.cend() - 1);
+  BOOST_CHECK_EQUAL(copy.popFirst(), T(1));
+  BOOST_CHECK_EQUAL(vector.popLast(), T(5));
+
+  thenVectorContainsValues(vector, { 1, 2, 3, 4 });
+  thenVectorContainsValues(copy, { 5 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVector_WhenMoving_ThenSourceIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  CowVector<T> vector = { 1, 2 };
+
+  CowVector<T> moved = std::move(vector);
+
+  BOOST_CHECK(vector.isEmpty());
+  thenVectorContainsValues(moved, { 1, 2 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenCopiesOnManyThreads_WhenEachWrites_ThenEveryThreadSeesOwnData)
+{
+  CowVector<int> vector;
+  for(int i = 0; i < 1000; ++i)
+    vector.append(i);
+  std::vector<CowVector<int>> copies(8, vector);
+  std::vector<std::thread> threads;
+
+  for(int t = 0; t < 8; ++t)
+    threads.emplace_back([&copies, t]() {
+      CowVector<int>& copy = copies[t];
+      for(int i = 0; i < 100; ++i) {
+        CowVector<int> snapshot = copy;
+        copy.append(t);
+      }
+    });
+  for(auto& thread : threads)
+    thread.join();
+
+  for(int t = 0; t < 8; ++t) {
+    BOOST_CHECK_EQUAL(copies[t].getSize(), 1100);
+    BOOST_CHECK_EQUAL(copies[t].count(t), 101);
+  }
+  BOOST_CHECK_EQUAL(vector.getSize(), 1000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,134 @@
+#include <FlatMap.h>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedTypes = boost::mpl::list<std::int32_t, std::uint64_t, double>;
+
+template <typename T>
+using FlatMap = aisdi::FlatMap<T, std::string>;
+
+BOOST_AUTO_TEST_SUITE(FlatMapTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  const FlatMap<T> map;
+
+  BOOST_CHECK(map.isEmpty());
+  BOOST_CHECK(map.find(T(1)) == map.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenInserting_ThenKeysAndValuesStayInStep,
+                              T,
+                              TestedTypes)
+{
+  FlatMap<T> map;
+
+  BOOST_CHECK(map.insert(T(3), "c"));
+  BOOST_CHECK(map.insert(T(1), "a"));
+  BOOST_CHECK(map.insert(T(2), "b"));
+  BOOST_CHECK(!map.insert(T(2), "x"));
+
+  BOOST_CHECK_EQUAL(map.getSize(), 3);
+  BOOST_CHECK_EQUAL(map.keys().data()[0], T(1));
+  BOOST_CHECK_EQUAL(map.values().data()[0], "a");
+  BOOST_CHECK_EQUAL(map.at(T(2)), "b");
+  BOOST_CHECK_EQUAL(map.at(T(3)), "c");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenAccessingMissingKey_ThenAtThrows,
+                              T,
+                              TestedTypes)
+{
+  const FlatMap<T> map = { { T(1), "a" } };
+
+  BOOST_CHECK_THROW(map.at(T(2)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenUsingSubscript_ThenMissingKeyIsDefaultInserted,
+                              T,
+                              TestedTypes)
+{
+  FlatMap<T> map = { { T(1), "a" } };
+
+  map[T(5)] += "e";
+  map[T(1)] += "a";
+
+  BOOST_CHECK_EQUAL(map.at(T(1)), "aa");
+  BOOST_CHECK_EQUAL(map.at(T(5)), "e");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenFinding_ThenIteratorExposesKeyAndValue,
+                              T,
+                              TestedTypes)
+{
+  FlatMap<T> map = { { T(10), "ten" }, { T(20), "twenty" } };
+
+  auto it = map.find(T(20));
+  BOOST_REQUIRE(it != map.end());
+  BOOST_CHECK_EQUAL(it.key(), T(20));
+  it.value() = "TWENTY";
+
+  BOOST_CHECK_EQUAL(map.at(T(20)), "TWENTY");
+  BOOST_CHECK(map.lowerBound(T(11)) == it);
+  BOOST_CHECK(++it == map.end());
+  BOOST_CHECK_THROW(it.value(), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenInsertingSortedRange_ThenExistingValuesAreKept,
+                              T,
+                              TestedTypes)
+{
+  FlatMap<T> map = { { T(2), "two" }, { T(4), "four" } };
+
+  map.insertSorted({ { T(1), "one" }, { T(2), "TWO" }, { T(5), "five" } });
+
+  BOOST_CHECK_EQUAL(map.getSize(), 4);
+  BOOST_CHECK_EQUAL(map.at(T(1)), "one");
+  BOOST_CHECK_EQUAL(map.at(T(2)), "two");
+  BOOST_CHECK_EQUAL(map.at(T(5)), "five");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenErasing_ThenKeyAndValueAreRemoved,
+                              T,
+                              TestedTypes)
+{
+  FlatMap<T> map = { { T(1), "a" }, { T(2), "b" }, { T(3), "c" } };
+
+  BOOST_CHECK(map.erase(T(2)));
+  BOOST_CHECK(!map.erase(T(2)));
+
+  BOOST_CHECK_EQUAL(map.getSize(), 2);
+  BOOST_CHECK_EQUAL(map.at(T(3)), "c");
+}
+
+BOOST_AUTO_TEST_CASE(GivenMapOfBools_WhenAccessingValues_ThenReferencesPointIntoTheMap)
+{
+  aisdi::FlatMap<int, bool> map = { { 2, true }, { 1, false } };
+
+  map[3] = true;
+  map.at(1) = true;
+  const aisdi::FlatMap<int, bool>& view = map;
+  const bool& second = view.at(2);
+  BOOST_CHECK(second);
+  map.find(2).value() = false;
+  BOOST_CHECK(!second);
+  map.insertSorted({ { 0, true }, { 4, false } });
+
+  BOOST_CHECK_EQUAL(map.getSize(), 5u);
+  BOOST_CHECK(map.at(0));
+  BOOST_CHECK(map.at(1));
+  BOOST_CHECK(!view.at(2));
+  BOOST_CHECK(view.find(3).value());
+  BOOST_CHECK(!map.at(4));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
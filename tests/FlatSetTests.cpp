@@ -0,0 +1,128 @@
+#include <FlatSet.h>
+
+#include <initializer_list>
+#include <cstdint>
+#include <functional>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedTypes = boost::mpl::list<std::int32_t, std::uint64_t, double>;
+
+template <typename T>
+using FlatSet = aisdi::FlatSet<T>;
+
+using std::begin;
+using std::end;
+
+BOOST_AUTO_TEST_SUITE(FlatSetTests)
+
+template <typename T>
+void thenSetContainsValues(const FlatSet<T>& set, std::initializer_list<int> expected)
+{
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(set), end(set), begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSet_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  const FlatSet<T> set;
+
+  BOOST_CHECK(set.isEmpty());
+  BOOST_CHECK(set.find(T(1)) == set.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSet_WhenInsertingUnsortedItems_ThenTheyAreKeptSortedAndUnique,
+                              T,
+                              TestedTypes)
+{
+  FlatSet<T> set;
+
+  BOOST_CHECK(set.insert(T(30)));
+  BOOST_CHECK(set.insert(T(10)));
+  BOOST_CHECK(set.insert(T(20)));
+  BOOST_CHECK(!set.insert(T(10)));
+
+  thenSetContainsValues(set, { 10, 20, 30 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSet_WhenFinding_ThenOnlyPresentKeysAreFound,
+                              T,
+                              TestedTypes)
+{
+  FlatSet<T> set;
+  for(int i = 0; i < 1000; i += 3)
+    set.insert(T(i));
+
+  for(int i = 0; i < 1000; ++i) {
+    auto it = set.find(T(i));
+    if(i % 3 == 0) {
+      BOOST_REQUIRE(it != set.end());
+      BOOST_CHECK_EQUAL(*it, T(i));
+    }
+    else
+      BOOST_CHECK(it == set.end());
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSet_WhenGettingLowerBound_ThenFirstNotSmallerKeyIsReturned,
+                              T,
+                              TestedTypes)
+{
+  const FlatSet<T> set = { 10, 20, 30, 40, 50 };
+
+  BOOST_CHECK(set.lowerBound(T(5)) == set.begin());
+  BOOST_CHECK(set.lowerBound(T(20)) == set.begin() + 1);
+  BOOST_CHECK(set.lowerBound(T(21)) == set.begin() + 2);
+  BOOST_CHECK(set.lowerBound(T(50)) == set.end() - 1);
+  BOOST_CHECK(set.lowerBound(T(51)) == set.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSet_WhenInsertingSortedRange_ThenRangesAreMerged,
+                              T,
+                              TestedTypes)
+{
+  FlatSet<T> set = { 2, 4, 6 };
+
+  set.insertSorted({ 1, 2, 3, 3, 7 });
+
+  thenSetContainsValues(set, { 1, 2, 3, 4, 6, 7 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSet_WhenInsertingSortedVector_ThenAllItemsAreAdded,
+                              T,
+                              TestedTypes)
+{
+  FlatSet<T> set = { 5 };
+  aisdi::Vector<T> items = { 1, 9 };
+
+  set.insertSorted(items);
+
+  thenSetContainsValues(set, { 1, 5, 9 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSet_WhenErasing_ThenOnlyPresentKeysAreRemoved,
+                              T,
+                              TestedTypes)
+{
+  FlatSet<T> set = { 1, 2, 3 };
+
+  BOOST_CHECK(set.erase(T(2)));
+  BOOST_CHECK(!set.erase(T(2)));
+
+  thenSetContainsValues(set, { 1, 3 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenSetWithCustomCompare_WhenInserting_ThenItemsFollowThatOrder)
+{
+  aisdi::FlatSet<int, std::greater<int>> set = { 1, 3, 2 };
+  std::initializer_list<int> expected = { 3, 2, 1 };
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(set), end(set), begin(expected), end(expected));
+  BOOST_CHECK(set.contains(2));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
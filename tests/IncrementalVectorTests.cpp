@@ -0,0 +1,235 @@
+#include <IncrementalVector.h>
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedTypes = boost::mpl::list<std::int32_t, std::uint64_t, std::complex<std::int32_t>>;
+
+template <typename T>
+using IncrementalVector = aisdi::IncrementalVector<T>;
+
+namespace
+{
+
+template <typename T>
+void thenVectorContainsRange(const IncrementalVector<T>& vector, int count)
+{
+  BOOST_REQUIRE_EQUAL(vector.getSize(), std::size_t(count));
+  for(int i = 0; i < count; ++i)
+    BOOST_CHECK_EQUAL(vector.at(i), T(i));
+}
+
+template <typename T>
+void appendRange(IncrementalVector<T>& vector, int from, int to)
+{
+  for(int i = from; i < to; ++i)
+    vector.append(T(i));
+}
+
+// Fills a vector with step 1 up to its start capacity and appends once more,
+// leaving almost the whole previous buffer waiting to be migrated.
+template <typename T>
+IncrementalVector<T> thenGrownVector()
+{
+  IncrementalVector<T> vector(1);
+  int full = static_cast<int>(IncrementalVector<T>::START_CAPACITY);
+  appendRange(vector, 0, full + 1);
+  return vector;
+}
+
+// Counts live objects, to check when buffer slots are destroyed.
+struct Tracked
+{
+  static int live;
+  int value;
+
+  Tracked(int v = 0) : value(v) { ++live; }
+  Tracked(const Tracked& other) : value(other.value) { ++live; }
+  Tracked& operator=(const Tracked& other) = default;
+  ~Tracked() { --live; }
+};
+
+int Tracked::live = 0;
+
+}
+
+BOOST_AUTO_TEST_SUITE(IncrementalVectorTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyVector_ThenNothingIsMigrating,
+                              T,
+                              TestedTypes)
+{
+  const IncrementalVector<T> vector;
+
+  BOOST_CHECK(vector.isEmpty());
+  BOOST_CHECK(!vector.isMigrating());
+  BOOST_CHECK(vector.begin() == vector.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFullVector_WhenAppending_ThenOnlyOneStepIsMigrated,
+                              T,
+                              TestedTypes)
+{
+  IncrementalVector<T> vector(4);
+  int full = static_cast<int>(IncrementalVector<T>::START_CAPACITY);
+  appendRange(vector, 0, full);
+
+  vector.append(T(full));
+  std::size_t pending = vector.pendingMigration();
+  vector.append(T(full + 1));
+
+  BOOST_CHECK(vector.isMigrating());
+  BOOST_CHECK_EQUAL(pending, std::size_t(full));
+  BOOST_CHECK_EQUAL(vector.pendingMigration(), pending - 4);
+  BOOST_CHECK_EQUAL(vector.getCapacity(), 2 * std::size_t(full));
+  thenVectorContainsRange(vector, full + 2);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMigratingVector_WhenAppendingUntilFull_ThenMigrationFinishesBeforeNextGrowth,
+                              T,
+                              TestedTypes)
+{
+  IncrementalVector<T> vector = thenGrownVector<T>();
+  int capacity = static_cast<int>(vector.getCapacity());
+
+  appendRange(vector, static_cast<int>(vector.getSize()), capacity);
+  BOOST_CHECK_LE(vector.pendingMigration(), vector.getMigrationStep());
+  vector.append(T(capacity));
+  BOOST_CHECK_EQUAL(vector.pendingMigration(), std::size_t(capacity));
+  appendRange(vector, capacity + 1, 4 * capacity);
+
+  thenVectorContainsRange(vector, 4 * capacity);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMigratingVector_WhenWritingThroughIterator_ThenValueIsKeptAfterMigration,
+                              T,
+                              TestedTypes)
+{
+  IncrementalVector<T> vector = thenGrownVector<T>();
+  int size = static_cast<int>(vector.getSize());
+
+  *(vector.begin() + (size - 2)) = T(100);
+  vector.finishMigration();
+
+  BOOST_CHECK(!vector.isMigrating());
+  BOOST_CHECK_EQUAL(vector.at(size - 2), T(100));
+  BOOST_CHECK_EQUAL(vector.at(size - 1), T(size - 1));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMigratingVector_WhenPoppingBelowOldSize_ThenRemainingItemsAreKept,
+                              T,
+                              TestedTypes)
+{
+  IncrementalVector<T> vector = thenGrownVector<T>();
+  int size = static_cast<int>(vector.getSize());
+
+  for(int i = size - 1; i >= 5; --i)
+    BOOST_CHECK_EQUAL(vector.popLast(), T(i));
+  appendRange(vector, 5, 8);
+
+  thenVectorContainsRange(vector, 8);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMigratingVector_WhenMigrationAdvances_ThenOldElementsAreDestroyedAsTheyMove)
+{
+  {
+    aisdi::IncrementalVector<Tracked> vector(4);
+    int full = static_cast<int>(aisdi::IncrementalVector<Tracked>::START_CAPACITY);
+    for(int i = 0; i <= full; ++i)
+      vector.append(Tracked(i));
+    int grown = Tracked::live;
+
+    vector.append(Tracked(full + 1));
+    BOOST_CHECK_EQUAL(Tracked::live, grown - 4);
+    vector.finishMigration();
+    BOOST_CHECK_EQUAL(Tracked::live, grown - full);
+    BOOST_CHECK_EQUAL(vector.at(full + 1).value, full + 1);
+  }
+  {
+    aisdi::IncrementalVector<Tracked> vector(1);
+    for(int i = 0; i < 17; ++i)
+      vector.append(Tracked(i));
+    while(vector.getSize() > 5)
+      vector.popLast();
+    BOOST_CHECK_EQUAL(vector.at(4).value, 4);
+  }
+  {
+    aisdi::IncrementalVector<Tracked> vector(1);
+    for(int i = 0; i < 17; ++i)
+      vector.append(Tracked(i));
+    BOOST_CHECK(vector.isMigrating());
+  }
+
+  BOOST_CHECK_EQUAL(Tracked::live, 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMigratingVector_WhenInsertingAndErasing_ThenItemsAreShifted,
+                              T,
+                              TestedTypes)
+{
+  IncrementalVector<T> vector = thenGrownVector<T>();
+  int size = static_cast<int>(vector.getSize());
+
+  vector.prepend(T(-1));
+  vector.insert(vector.cbegin() + 1, T(-2));
+  vector.erase(vector.cbegin(), vector.cbegin() + 2);
+  vector.erase(vector.cend() - 1);
+  vector.append(T(size - 1));
+
+  BOOST_CHECK(!vector.isMigrating());
+  thenVectorContainsRange(vector, size);
+  BOOST_CHECK_EQUAL(vector.popFirst(), T(0));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMigratingVector_WhenCopying_ThenCopyHoldsAllItems,
+                              T,
+                              TestedTypes)
+{
+  const IncrementalVector<T> vector = thenGrownVector<T>();
+  int size = static_cast<int>(vector.getSize());
+
+  IncrementalVector<T> copy = vector;
+  IncrementalVector<T> moved = std::move(copy);
+
+  BOOST_CHECK(!moved.isMigrating());
+  BOOST_CHECK(copy.isEmpty());
+  thenVectorContainsRange(moved, size);
+  thenVectorContainsRange(vector, size);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVector_WhenInsertingOwnItemWhileFull_ThenItemIsCopiedFirst,
+                              T,
+                              TestedTypes)
+{
+  IncrementalVector<T> vector(1);
+  int full = static_cast<int>(IncrementalVector<T>::START_CAPACITY);
+  appendRange(vector, 0, full);
+
+  vector.insert(vector.cbegin(), vector.at(full - 1));
+
+  BOOST_CHECK_EQUAL(vector.at(0), T(full - 1));
+  BOOST_CHECK_EQUAL(vector.at(1), T(0));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyVector_WhenPoppingOrErasing_ThenExceptionIsThrown,
+                              T,
+                              TestedTypes)
+{
+  IncrementalVector<T> vector;
+
+  BOOST_CHECK_THROW(vector.popLast(), std::logic_error);
+  BOOST_CHECK_THROW(vector.popFirst(), std::logic_error);
+  BOOST_CHECK_THROW(vector.erase(vector.cbegin()), std::out_of_range);
+  BOOST_CHECK_THROW(vector.at(0), std::out_of_range);
+  BOOST_CHECK_THROW(*vector.cend(), std::out_of_range);
+  BOOST_CHECK_THROW(vector.cbegin() - 1, std::out_of_range);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,92 @@
+#include <LatencyHistogram.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+using aisdi::LatencyHistogram;
+
+BOOST_AUTO_TEST_SUITE(LatencyHistogramTests)
+
+BOOST_AUTO_TEST_CASE(GivenEmptyHistogram_ThenEverySummaryIsZero)
+{
+  const LatencyHistogram histogram;
+
+  BOOST_CHECK_EQUAL(histogram.count(), 0u);
+  BOOST_CHECK_EQUAL(histogram.min(), 0u);
+  BOOST_CHECK_EQUAL(histogram.max(), 0u);
+  BOOST_CHECK_EQUAL(histogram.valueAtPercentile(99), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSmallValues_WhenRecorded_ThenPercentilesAreExact)
+{
+  LatencyHistogram histogram;
+
+  for(std::uint64_t v = 1; v <= 100; ++v)
+    histogram.record(v);
+
+  BOOST_CHECK_EQUAL(histogram.count(), 100u);
+  BOOST_CHECK_EQUAL(histogram.valueAtPercentile(50), 50u);
+  BOOST_CHECK_EQUAL(histogram.valueAtPercentile(90), 90u);
+  BOOST_CHECK_EQUAL(histogram.valueAtPercentile(99.9), 100u);
+  BOOST_CHECK_EQUAL(histogram.min(), 1u);
+  BOOST_CHECK_CLOSE(histogram.mean(), 50.5, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(GivenLargeValues_WhenRecorded_ThenPercentilesStayWithinBucketPrecision)
+{
+  LatencyHistogram histogram;
+  const double precision = 100.0 / std::size_t(LatencyHistogram::HALF_BUCKETS);
+
+  for(std::uint64_t v = 1; v <= 10000; ++v)
+    histogram.record(v * 1000);
+
+  BOOST_CHECK_CLOSE(double(histogram.valueAtPercentile(50)), 5000000.0, precision);
+  BOOST_CHECK_CLOSE(double(histogram.valueAtPercentile(99)), 9900000.0, precision);
+  BOOST_CHECK_EQUAL(histogram.valueAtPercentile(100), 10000000u);
+  BOOST_CHECK_EQUAL(histogram.max(), 10000000u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenRareSpike_WhenRecorded_ThenOnlyTheTailShowsIt)
+{
+  LatencyHistogram histogram;
+
+  histogram.record(30, 9990);
+  histogram.record(200000, 10);
+
+  BOOST_CHECK_EQUAL(histogram.valueAtPercentile(99), 30u);
+  BOOST_CHECK_GE(histogram.valueAtPercentile(99.95), 200000u - 200000u / 64);
+  BOOST_CHECK_EQUAL(histogram.max(), 200000u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenAnyValue_ThenItFallsWithinItsBucketBounds)
+{
+  for(std::uint64_t v : { std::uint64_t(0), std::uint64_t(127), std::uint64_t(128), std::uint64_t(1000),
+                          std::uint64_t(123456789), UINT64_MAX }) {
+    std::size_t bucket = LatencyHistogram::bucketOf(v);
+    BOOST_CHECK_LT(bucket, std::size_t(LatencyHistogram::BUCKET_COUNT));
+    BOOST_CHECK_LE(LatencyHistogram::lowestEquivalent(bucket), v);
+    BOOST_CHECK_GE(LatencyHistogram::highestEquivalent(bucket), v);
+  }
+  BOOST_CHECK_EQUAL(LatencyHistogram::bucketOf(UINT64_MAX), std::size_t(LatencyHistogram::BUCKET_COUNT) - 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenTwoHistograms_WhenMerged_ThenCountsAndExtremesCombine)
+{
+  LatencyHistogram first, second;
+  first.record(10, 3);
+  second.record(5);
+  second.record(5000);
+
+  first.merge(second);
+
+  BOOST_CHECK_EQUAL(first.count(), 5u);
+  BOOST_CHECK_EQUAL(first.min(), 5u);
+  BOOST_CHECK_EQUAL(first.max(), 5000u);
+  first.reset();
+  BOOST_CHECK_EQUAL(first.count(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
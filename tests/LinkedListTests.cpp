@@ -3,6 +3,7 @@
 #include <initializer_list>
 #include <complex>
 #include <cstdint>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/test_tools.hpp>
@@ -716,6 +717,39 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingRange_ThenSizeI
   BOOST_CHECK_EQUAL(collection.getSize(), 2);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenRemovingIf_ThenOnlyNonMatchingItemsRemainInOrder,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 4, 5, 6, 7 };
+
+  auto removed = collection.removeIf([](const T& item) { return item == T(2) || item == T(3) || item == T(6); });
+  auto none = aisdi::eraseIf(collection, [](const T& item) { return item == T(100); });
+
+  BOOST_CHECK_EQUAL(removed, 3u);
+  BOOST_CHECK_EQUAL(none, 0u);
+  BOOST_REQUIRE_EQUAL(collection.getSize(), 4u);
+  BOOST_CHECK_EQUAL(*collection.cbegin(), T(1));
+  BOOST_CHECK_EQUAL(*(collection.cbegin() + 1), T(4));
+  BOOST_CHECK_EQUAL(*(collection.cbegin() + 2), T(5));
+  BOOST_CHECK_EQUAL(*(collection.cbegin() + 3), T(7));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenApplyingMixedEdits_ThenItemsAreMergedInOrder,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 0, 1, 2, 3, 4, 5 };
+  using Edit = aisdi::Edit<T>;
+  std::vector<Edit> edits = { Edit::insert(0, T(-1)), Edit::erase(1), Edit::erase(2), Edit::insert(4, T(40)),
+                              Edit::insert(4, T(41)), Edit::replace(4, T(44)), Edit::erase(5), Edit::insert(6, T(60)) };
+
+  collection.applyEdits(edits);
+
+  thenCollectionContainsValues(collection, { -1, 0, 3, 40, 41, 44, 60 });
+  BOOST_CHECK_THROW(collection.applyEdits(std::vector<Edit>{ Edit::replace(7, T(0)) }), std::out_of_range);
+}
+
 // ConstIterator is tested via Iterator methods.
 // If Iterator methods are to be changed, then new ConstIterator tests are required.
 
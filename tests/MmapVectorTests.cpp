@@ -0,0 +1,196 @@
+#include <MmapVector.h>
+
+#include <initializer_list>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedTypes = boost::mpl::list<std::int32_t, std::uint64_t, std::complex<std::int32_t>>;
+
+template <typename T>
+using MmapVector = aisdi::MmapVector<T>;
+using Mode = aisdi::MmapMode;
+
+using std::begin;
+using std::end;
+
+namespace
+{
+
+struct TemporaryFile
+{
+  std::string path;
+
+  TemporaryFile() : path("/tmp/aisdi_mmap_vector_" + std::to_string(::getpid())) {
+    std::remove(path.c_str());
+  }
+
+  ~TemporaryFile() {
+    std::remove(path.c_str());
+  }
+};
+
+template <typename T>
+void thenVectorContainsValues(const MmapVector<T>& vector, std::initializer_list<int> expected)
+{
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(vector), end(vector), begin(expected), end(expected));
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(MmapVectorTests, TemporaryFile)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNewFile_WhenOpening_ThenVectorIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  const MmapVector<T> vector(path);
+
+  BOOST_CHECK(vector.isEmpty());
+  BOOST_CHECK(vector.begin() == vector.end());
+  BOOST_CHECK(!vector.isReadOnly());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVector_WhenAppendingAndPopping_ThenItBehavesLikeVector,
+                              T,
+                              TestedTypes)
+{
+  MmapVector<T> vector(path);
+
+  vector.append(T(1));
+  vector.append(T(2));
+  vector.append(T(3));
+
+  BOOST_CHECK_EQUAL(vector.popLast(), T(3));
+  *vector.begin() = T(10);
+  thenVectorContainsValues(vector, { 10, 2 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMovedFromVector_WhenUsed_ThenItIsEmptyAndRefusesWrites,
+                              T,
+                              TestedTypes)
+{
+  MmapVector<T> vector(path);
+  vector.append(T(1));
+
+  MmapVector<T> moved = std::move(vector);
+
+  BOOST_CHECK(vector.isEmpty());
+  BOOST_CHECK_EQUAL(vector.getCapacity(), 0u);
+  BOOST_CHECK(vector.begin() == vector.end());
+  BOOST_CHECK_THROW(vector.append(T(2)), std::logic_error);
+  BOOST_CHECK_THROW(vector.popLast(), std::logic_error);
+  vector.flush();
+  vector = std::move(moved);
+  thenVectorContainsValues(vector, { 1 });
+  BOOST_CHECK(moved.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVector_WhenGrowingPastCapacity_ThenAllItemsAreKept,
+                              T,
+                              TestedTypes)
+{
+  MmapVector<T> vector(path);
+  const std::size_t initialCapacity = vector.getCapacity();
+
+  for(std::size_t i = 0; i < 5 * initialCapacity; ++i)
+    vector.append(T(static_cast<int>(i)));
+  vector.append(*vector.begin()); // element from the mapping that is moved
+
+  BOOST_CHECK(vector.getCapacity() >= 5 * initialCapacity + 1);
+  BOOST_REQUIRE_EQUAL(vector.getSize(), 5 * initialCapacity + 1);
+  for(std::size_t i = 0; i < 5 * initialCapacity; ++i)
+    BOOST_REQUIRE_EQUAL(vector.data()[i], T(static_cast<int>(i)));
+  BOOST_CHECK_EQUAL(*(vector.end() - 1), T(0));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFlushedVector_WhenReopeningReadOnly_ThenItemsAreThere,
+                              T,
+                              TestedTypes)
+{
+  {
+    MmapVector<T> vector(path, Mode::Truncate);
+    for(int i = 0; i < 3000; ++i)
+      vector.append(T(i));
+    vector.flush();
+  }
+
+  MmapVector<T> reopened(path, Mode::ReadOnly);
+
+  BOOST_CHECK(reopened.isReadOnly());
+  BOOST_REQUIRE_EQUAL(reopened.getSize(), 3000);
+  BOOST_CHECK_EQUAL(*(reopened.cbegin() + 2999), T(2999));
+  BOOST_CHECK_THROW(reopened.append(T(1)), std::logic_error);
+  BOOST_CHECK_THROW(reopened.popLast(), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenFileWithOtherElementSize_WhenOpening_ThenOperationThrows)
+{
+  {
+    MmapVector<std::uint64_t> vector(path);
+    vector.append(1);
+  }
+
+  BOOST_CHECK_THROW(MmapVector<std::int32_t>(path, Mode::ReadOnly), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenHeaderWithZeroCapacity_WhenOpening_ThenOperationThrows)
+{
+  {
+    MmapVector<std::int32_t> vector(path);
+  }
+  int fd = ::open(path.c_str(), O_RDWR);
+  BOOST_REQUIRE(fd >= 0);
+  const std::uint64_t zero = 0;
+  BOOST_CHECK_EQUAL(::pwrite(fd, &zero, sizeof(zero), 24), static_cast<ssize_t>(sizeof(zero))); // Header::capacity
+  BOOST_CHECK_EQUAL(::ftruncate(fd, 64), 0);
+  ::close(fd);
+
+  BOOST_CHECK_THROW(MmapVector<std::int32_t>(path, Mode::ReadWrite), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenReservingMoreThanAFileCanHold_ThenOperationThrows)
+{
+  MmapVector<std::uint64_t> vector(path);
+  vector.append(1);
+
+  BOOST_CHECK_THROW(vector.reserve(std::numeric_limits<std::size_t>::max() / 4), std::out_of_range);
+  thenVectorContainsValues(vector, { 1 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenFileWhichIsNotAVector_WhenOpening_ThenOperationThrows)
+{
+  std::FILE* file = std::fopen(path.c_str(), "w");
+  std::fputs("definitely not a vector header, but long enough to hold one..........", file);
+  std::fclose(file);
+
+  BOOST_CHECK_THROW(MmapVector<int>{ path }, std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMissingFile_WhenOpeningReadOnly_ThenOperationThrows)
+{
+  BOOST_CHECK_THROW(MmapVector<int>(path, Mode::ReadOnly), std::system_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenIterator_WhenMovingPastBounds_ThenOperationThrows)
+{
+  MmapVector<int> vector(path);
+  vector.append(1);
+
+  BOOST_CHECK_THROW(*vector.end(), std::out_of_range);
+  BOOST_CHECK_THROW(vector.end()++, std::out_of_range);
+  BOOST_CHECK_THROW(vector.begin()--, std::out_of_range);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,50 @@
+#include <PerfCounters.h>
+
+#include <cstdint>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+using aisdi::PerfCounters;
+
+BOOST_AUTO_TEST_SUITE(PerfCountersTests)
+
+// Counters may be unavailable where the tests run (containers, restricted
+// perf_event_paranoid), so each check holds either way.
+
+BOOST_AUTO_TEST_CASE(GivenCounters_WhenStopped_ThenOnlyOpenedEventsAreValid)
+{
+  PerfCounters counters;
+  volatile std::uint64_t sink = 0;
+
+  counters.start();
+  for(int i = 0; i < 100000; ++i)
+    sink += i;
+  PerfCounters::Sample sample = counters.stop();
+
+  for(int e = 0; e < PerfCounters::EVENT_COUNT; ++e)
+    if(!counters.isAvailable(static_cast<PerfCounters::Event>(e)))
+      BOOST_CHECK(!sample.valid[e]);
+  if(sample.valid[PerfCounters::INSTRUCTIONS])
+    BOOST_CHECK_GT(sample.values[PerfCounters::INSTRUCTIONS], 100000);
+  if(!counters.isAvailable())
+    BOOST_CHECK(sample.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenUnavailableCounters_WhenAskingWhy_ThenReasonIsGiven)
+{
+  PerfCounters counters;
+
+  if(!counters.isAvailable())
+    BOOST_CHECK(!counters.unavailableReason().empty());
+  BOOST_CHECK_EQUAL(PerfCounters::eventName(PerfCounters::DTLB_MISSES), "dtlb_misses");
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptySample_ThenNoEventIsValid)
+{
+  PerfCounters::Sample sample;
+
+  BOOST_CHECK(sample.isEmpty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,185 @@
+#include <PersistentVector.h>
+
+#include <initializer_list>
+#include <complex>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedTypes = boost::mpl::list<std::int32_t, std::uint64_t, std::complex<std::int32_t>>;
+
+template <typename T>
+using PersistentVector = aisdi::PersistentVector<T>;
+
+using std::begin;
+using std::end;
+
+BOOST_AUTO_TEST_SUITE(PersistentVectorTests)
+
+template <typename T>
+void thenVectorContainsValues(const PersistentVector<T>& vector, std::initializer_list<int> expected)
+{
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(vector), end(vector), begin(expected), end(expected));
+}
+
+template <typename T>
+PersistentVector<T> givenVectorOfSize(int size)
+{
+  auto builder = PersistentVector<T>().transient();
+  for(int i = 0; i < size; ++i)
+    builder.append(T(i));
+  return builder.persistent();
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVector_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  const PersistentVector<T> vector;
+
+  BOOST_CHECK(vector.isEmpty());
+  BOOST_CHECK(vector.begin() == vector.end());
+  BOOST_CHECK_THROW(vector.at(0), std::out_of_range);
+  BOOST_CHECK_THROW(vector.popLast(), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVector_WhenAppending_ThenNewVersionIsReturnedAndOldIsUnchanged,
+                              T,
+                              TestedTypes)
+{
+  const PersistentVector<T> before = { 1, 2 };
+
+  const PersistentVector<T> after = before.append(T(3));
+
+  thenVectorContainsValues(before, { 1, 2 });
+  thenVectorContainsValues(after, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVector_WhenSetting_ThenOnlyNewVersionSeesTheChange,
+                              T,
+                              TestedTypes)
+{
+  const PersistentVector<T> before = { 1, 2, 3 };
+
+  const PersistentVector<T> after = before.set(1, T(20));
+
+  thenVectorContainsValues(before, { 1, 2, 3 });
+  thenVectorContainsValues(after, { 1, 20, 3 });
+  BOOST_CHECK_THROW(before.set(3, T(4)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeVector_WhenAppendingOneByOne_ThenAllItemsAreReachable,
+                              T,
+                              TestedTypes)
+{
+  PersistentVector<T> vector;
+  const int size = 33 * 32 * 32 + 5; // three trie levels
+
+  for(int i = 0; i < size; ++i)
+    vector = vector.append(T(i));
+
+  BOOST_REQUIRE_EQUAL(vector.getSize(), size);
+  int expected = 0;
+  for(auto it = vector.begin(); it != vector.end(); ++it, ++expected)
+    BOOST_REQUIRE_EQUAL(*it, T(expected));
+  BOOST_CHECK_EQUAL(vector.at(1024), T(1024));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeVector_WhenSettingEverywhere_ThenOriginalIsKept,
+                              T,
+                              TestedTypes)
+{
+  const PersistentVector<T> original = givenVectorOfSize<T>(2000);
+  PersistentVector<T> changed = original;
+
+  for(int i = 0; i < 2000; i += 7)
+    changed = changed.set(i, T(-i));
+
+  for(int i = 0; i < 2000; ++i) {
+    BOOST_REQUIRE_EQUAL(original.at(i), T(i));
+    BOOST_REQUIRE_EQUAL(changed.at(i), i % 7 ? T(i) : T(-i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeVector_WhenPoppingAll_ThenEveryVersionStaysConsistent,
+                              T,
+                              TestedTypes)
+{
+  const PersistentVector<T> full = givenVectorOfSize<T>(32 * 32 + 40);
+  PersistentVector<T> vector = full;
+
+  while(!vector.isEmpty()) {
+    vector = vector.popLast();
+    if(!vector.isEmpty())
+      BOOST_REQUIRE_EQUAL(vector.at(vector.getSize() - 1), T(vector.getSize() - 1));
+  }
+
+  BOOST_CHECK_EQUAL(full.getSize(), 32 * 32 + 40);
+  BOOST_CHECK_EQUAL(full.at(32 * 32 + 39), T(32 * 32 + 39));
+  vector = vector.append(T(8));
+  thenVectorContainsValues(vector, { 8 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTransient_WhenEditingAfterPublishing_ThenPublishedVersionIsUnchanged,
+                              T,
+                              TestedTypes)
+{
+  const PersistentVector<T> base = givenVectorOfSize<T>(100);
+  auto builder = base.transient();
+  builder.set(0, T(7)).append(T(100));
+
+  const PersistentVector<T> published = builder.persistent();
+  builder.set(0, T(8)).set(99, T(9)).popLast();
+
+  BOOST_CHECK_EQUAL(base.at(0), T(0));
+  BOOST_CHECK_EQUAL(base.getSize(), 100);
+  BOOST_CHECK_EQUAL(published.at(0), T(7));
+  BOOST_CHECK_EQUAL(published.at(99), T(99));
+  BOOST_CHECK_EQUAL(published.getSize(), 101);
+  BOOST_CHECK_EQUAL(builder.persistent().at(0), T(8));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTransient_WhenMoved_ThenOnlyTheTargetOwnsTheEdits,
+                              T,
+                              TestedTypes)
+{
+  using Transient = typename PersistentVector<T>::Transient;
+  static_assert(!std::is_copy_constructible<Transient>::value, "Transient copies would share nodes");
+  static_assert(!std::is_copy_assignable<Transient>::value, "Transient copies would share nodes");
+
+  const PersistentVector<T> base = givenVectorOfSize<T>(40);
+  Transient source = base.transient();
+  source.set(0, T(7));
+
+  Transient target = std::move(source);
+  BOOST_CHECK(source.isEmpty());
+  source.append(T(1));
+  target.set(1, T(8));
+  source = base.transient();
+  source.set(0, T(9));
+
+  BOOST_CHECK_EQUAL(target.at(0), T(7));
+  BOOST_CHECK_EQUAL(target.at(1), T(8));
+  BOOST_CHECK_EQUAL(source.at(0), T(9));
+  BOOST_CHECK_EQUAL(source.at(1), T(1));
+  BOOST_CHECK_EQUAL(base.at(0), T(0));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenMovingPastBounds_ThenOperationThrows,
+                              T,
+                              TestedTypes)
+{
+  const PersistentVector<T> vector = { 1 };
+
+  BOOST_CHECK_THROW(*vector.end(), std::out_of_range);
+  BOOST_CHECK_THROW(++vector.end(), std::out_of_range);
+  BOOST_CHECK_THROW(--vector.begin(), std::out_of_range);
+  BOOST_CHECK_EQUAL(*(vector.end() - 1), T(1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
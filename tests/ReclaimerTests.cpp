@@ -0,0 +1,187 @@
+#include <Reclaimer.h>
+#include <LinkedList.h>
+#include <Vector.h>
+
+#include <atomic>
+#include <chrono>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedTypes = boost::mpl::list<std::int32_t, std::uint64_t, std::complex<std::int32_t>>;
+
+namespace
+{
+
+std::atomic<int> deletedBuffers{ 0 };
+std::thread::id deletingThread;
+
+template <typename T>
+void freeForeign(T* data, std::size_t capacity)
+{
+  for(std::size_t i = 0; i < capacity + 1; ++i)
+    data[i].~T();
+  std::free(data);
+  deletingThread = std::this_thread::get_id();
+  ++deletedBuffers;
+}
+
+template <typename T>
+T* foreignBuffer(std::size_t capacity)
+{
+  void* raw = nullptr;
+  if(posix_memalign(&raw, 64, (capacity + 1) * sizeof(T)))
+    throw std::bad_alloc();
+  T* data = static_cast<T*>(raw);
+  for(std::size_t i = 0; i < capacity + 1; ++i)
+    new (data + i) T(static_cast<int>(i));
+  return data;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ReclaimerTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenList_WhenDestroyingAsync_ThenListIsEmptyAndNodesAreFreed,
+                              T,
+                              TestedTypes)
+{
+  aisdi::Reclaimer reclaimer;
+  aisdi::LinkedList<T, aisdi::CountingStats> list;
+  for(int i = 0; i < 100000; ++i)
+    list.append(T(i));
+
+  list.destroyAsync(reclaimer);
+  reclaimer.flush();
+
+  BOOST_CHECK(list.isEmpty());
+  BOOST_CHECK(list.begin() == list.end());
+  BOOST_CHECK_EQUAL(list.stats().counters().nodeFrees, 100000u);
+  BOOST_CHECK_EQUAL(list.stats().counters().liveNodes, 0);
+  BOOST_CHECK_EQUAL(reclaimer.pending(), 0u);
+
+  list.append(T(7));
+  list.prepend(T(6));
+  BOOST_CHECK_EQUAL(list.popLast(), T(7));
+  BOOST_CHECK_EQUAL(list.popFirst(), T(6));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVectorWithAdoptedBuffer_WhenDestroyingAsync_ThenDeleterRunsOnReclaimerThread,
+                              T,
+                              TestedTypes)
+{
+  aisdi::Reclaimer reclaimer;
+  aisdi::Vector<T> vector;
+  vector.adopt(foreignBuffer<T>(1000), 1000, 1000, &freeForeign<T>);
+  int deleted = deletedBuffers;
+
+  vector.destroyAsync(reclaimer);
+  reclaimer.flush();
+
+  BOOST_CHECK(vector.isEmpty());
+  BOOST_CHECK(vector.ownsBuffer());
+  BOOST_CHECK_EQUAL(deletedBuffers, deleted + 1);
+  BOOST_CHECK(deletingThread != std::this_thread::get_id());
+  vector.append(T(1));
+  BOOST_CHECK_EQUAL(vector.getSize(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenBoolVector_WhenDestroyingAsync_ThenVectorIsEmptyAndWordsAreFreed)
+{
+  aisdi::Reclaimer reclaimer;
+  aisdi::Vector<bool, 64, aisdi::CountingStats> flags;
+  for(int i = 0; i < 100000; ++i)
+    flags.append(i % 3 == 0);
+
+  flags.destroyAsync(reclaimer);
+  reclaimer.flush();
+
+  BOOST_CHECK(flags.isEmpty());
+  BOOST_CHECK_EQUAL(flags.count(), 0u);
+  BOOST_CHECK_EQUAL(flags.stats().counters().allocations - flags.stats().counters().frees, 1u);
+  BOOST_CHECK_EQUAL(reclaimer.pending(), 0u);
+  flags.append(true);
+  BOOST_CHECK_EQUAL(flags.count(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSmallQueue_WhenSubmittingManyJobs_ThenQueueStaysBoundedAndFlushRunsAll)
+{
+  aisdi::Reclaimer reclaimer(2);
+  std::atomic<int> done{ 0 };
+  std::size_t mostPending = 0;
+
+  for(int i = 0; i < 50; ++i) {
+    reclaimer.submit([&done] {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      ++done;
+    });
+    std::size_t pending = reclaimer.pending();
+    if(pending > mostPending)
+      mostPending = pending;
+  }
+  reclaimer.flush();
+
+  BOOST_CHECK_LE(mostPending, 3u); // two queued and one running
+  BOOST_CHECK_EQUAL(done, 50);
+  BOOST_CHECK_EQUAL(reclaimer.pending(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenJobSubmittingJobs_WhenFlushing_ThenNestedJobsRunInline)
+{
+  aisdi::Reclaimer reclaimer(1);
+  std::atomic<int> done{ 0 };
+
+  reclaimer.submit([&reclaimer, &done] {
+    for(int i = 0; i < 10; ++i)
+      reclaimer.submit([&done] { ++done; });
+  });
+  reclaimer.flush();
+
+  BOOST_CHECK_EQUAL(done, 10);
+}
+
+BOOST_AUTO_TEST_CASE(GivenJobCallingFlush_WhenItRuns_ThenQueuedJobsRunInlineWithoutDeadlock)
+{
+  aisdi::Reclaimer reclaimer(4);
+  std::atomic<bool> release{ false };
+  std::atomic<int> done{ 0 };
+  int doneAtFlush = -1;
+
+  reclaimer.submit([&] {
+    while(!release)
+      std::this_thread::yield();
+    reclaimer.flush();
+    doneAtFlush = done;
+  });
+  for(int i = 0; i < 3; ++i)
+    reclaimer.submit([&done] { ++done; });
+  release = true;
+  reclaimer.flush();
+
+  BOOST_CHECK_EQUAL(doneAtFlush, 3);
+  BOOST_CHECK_EQUAL(done, 3);
+  BOOST_CHECK_EQUAL(reclaimer.pending(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenQueuedJobs_WhenReclaimerIsDestroyed_ThenAllJobsRun)
+{
+  std::atomic<int> done{ 0 };
+  {
+    aisdi::Reclaimer reclaimer;
+    for(int i = 0; i < 20; ++i)
+      reclaimer.submit([&done] { ++done; });
+  }
+
+  BOOST_CHECK_EQUAL(done, 20);
+  BOOST_CHECK_THROW(aisdi::Reclaimer(0), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
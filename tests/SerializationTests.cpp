@@ -0,0 +1,210 @@
+#include <Serialization.h>
+
+#include <initializer_list>
+#include <algorithm>
+#include <climits>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedTypes = boost::mpl::list<std::int32_t, std::uint64_t, std::complex<std::int32_t>>;
+
+using std::begin;
+using std::end;
+
+namespace
+{
+
+struct TemporaryFile
+{
+  std::string path;
+  int fd;
+
+  TemporaryFile() : path("/tmp/aisdi_serialization_" + std::to_string(::getpid())) {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  }
+
+  ~TemporaryFile() {
+    ::close(fd);
+    std::remove(path.c_str());
+  }
+
+  void rewind() {
+    ::lseek(fd, 0, SEEK_SET);
+  }
+};
+
+template <typename Collection>
+void thenCollectionContainsValues(const Collection& collection, std::initializer_list<int> expected)
+{
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), begin(expected), end(expected));
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(SerializationTests, TemporaryFile)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVector_WhenSerializedAndDeserialized_ThenItemsAreEqual,
+                              T,
+                              TestedTypes)
+{
+  const aisdi::Vector<T> vector = { 4, 8, 15, 16, 23, 42 };
+  aisdi::Vector<T> result = { 99 };
+
+  aisdi::serialize(fd, vector);
+  rewind();
+  aisdi::deserialize(fd, result);
+
+  thenCollectionContainsValues(result, { 4, 8, 15, 16, 23, 42 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyList_WhenSerializedAndDeserialized_ThenResultIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  const aisdi::LinkedList<T> list;
+  aisdi::LinkedList<T> result = { 1, 2 };
+
+  aisdi::serialize(fd, list);
+  rewind();
+  aisdi::deserialize(fd, result);
+
+  BOOST_CHECK(result.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLongList_WhenSerialized_ThenItCanBeReadAsVector,
+                              T,
+                              TestedTypes)
+{
+  aisdi::LinkedList<T> list;
+  const int size = 3 * 1024 + 17; // several writev batches
+  for(int i = 0; i < size; ++i)
+    list.append(T(i));
+  aisdi::Vector<T> result;
+
+  aisdi::serialize(fd, list);
+  rewind();
+  aisdi::deserialize(fd, result);
+
+  BOOST_REQUIRE_EQUAL(result.getSize(), size);
+  for(int i = 0; i < size; ++i)
+    BOOST_REQUIRE_EQUAL(result.data()[i], T(i));
+}
+
+BOOST_AUTO_TEST_CASE(GivenLargeVector_WhenStreaming_ThenItIsDecodedChunkByChunk)
+{
+  aisdi::Vector<std::uint64_t> vector;
+  for(std::uint64_t i = 0; i < 100000; ++i)
+    vector.append(i * 3);
+  aisdi::serialize(fd, vector);
+  rewind();
+
+  aisdi::StreamReader<std::uint64_t> reader(fd);
+  aisdi::LinkedList<std::uint64_t> chunk;
+  std::uint64_t expected = 0;
+  int chunks = 0;
+  while(reader.readChunk(chunk)) {
+    BOOST_REQUIRE(chunk.getSize() <= reader.CHUNK_SIZE);
+    while(!chunk.isEmpty())
+      BOOST_REQUIRE_EQUAL(chunk.popFirst(), 3 * expected++);
+    ++chunks;
+  }
+
+  BOOST_CHECK_EQUAL(expected, 100000u);
+  BOOST_CHECK(chunks > 1);
+  BOOST_CHECK_EQUAL(reader.remaining(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenStreamOfOtherElementSize_WhenDeserializing_ThenOperationThrows)
+{
+  aisdi::serialize(fd, aisdi::Vector<std::uint64_t>{ 1, 2 });
+  rewind();
+  aisdi::Vector<std::int32_t> result;
+
+  BOOST_CHECK_THROW(aisdi::deserialize(fd, result), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenTruncatedStream_WhenDeserializing_ThenOperationThrows)
+{
+  aisdi::serialize(fd, aisdi::Vector<std::int32_t>{ 1, 2, 3 });
+  BOOST_REQUIRE_EQUAL(::ftruncate(fd, ::lseek(fd, 0, SEEK_CUR) - 2), 0);
+  rewind();
+  aisdi::LinkedList<std::int32_t> result;
+
+  BOOST_CHECK_THROW(aisdi::deserialize(fd, result), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenHeaderWithOversizedCount_WhenDeserializingVector_ThenOperationThrows)
+{
+  aisdi::detail::StreamHeader header = aisdi::detail::makeStreamHeader(sizeof(std::int32_t), 0);
+  header.count = std::uint64_t(1) << 32;
+  BOOST_REQUIRE_EQUAL(::write(fd, &header, sizeof(header)), static_cast<ssize_t>(sizeof(header)));
+  const std::int32_t payload[] = { 1, 2, 3 };
+  BOOST_REQUIRE_EQUAL(::write(fd, payload, sizeof(payload)), static_cast<ssize_t>(sizeof(payload)));
+  rewind();
+  aisdi::Vector<std::int32_t> result = { 7 };
+
+  BOOST_CHECK_THROW(aisdi::deserialize(fd, result), std::runtime_error);
+  thenCollectionContainsValues(result, { 7 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenTruncatedFile_WhenDeserializingVector_ThenOperationThrowsAndVectorIsUnchanged)
+{
+  aisdi::serialize(fd, aisdi::Vector<std::int32_t>{ 1, 2, 3 });
+  BOOST_REQUIRE_EQUAL(::ftruncate(fd, ::lseek(fd, 0, SEEK_CUR) - 2), 0);
+  rewind();
+  aisdi::Vector<std::int32_t> result = { 7 };
+
+  BOOST_CHECK_THROW(aisdi::deserialize(fd, result), std::runtime_error);
+  thenCollectionContainsValues(result, { 7 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenLargeVectorInPipe_WhenDeserializing_ThenStorageGrowsAsDataArrives)
+{
+  aisdi::Vector<std::uint64_t> vector;
+  for(std::uint64_t i = 0; i < 100000; ++i)
+    vector.append(i * 3);
+  int ends[2];
+  BOOST_REQUIRE_EQUAL(::pipe(ends), 0);
+  std::thread writer([&] {
+    aisdi::serialize(ends[1], vector);
+    ::close(ends[1]);
+  });
+  aisdi::Vector<std::uint64_t> result = { 7 };
+
+  aisdi::deserialize(ends[0], result);
+  writer.join();
+  ::close(ends[0]);
+
+  BOOST_REQUIRE_EQUAL(result.getSize(), vector.getSize());
+  BOOST_CHECK(std::equal(result.cbegin(), result.cend(), vector.cbegin()));
+}
+
+BOOST_AUTO_TEST_CASE(GivenPipeEndingBeforeForgedCount_WhenDeserializingVector_ThenOperationThrowsAndVectorIsEmpty)
+{
+  int ends[2];
+  BOOST_REQUIRE_EQUAL(::pipe(ends), 0);
+  aisdi::detail::StreamHeader header = aisdi::detail::makeStreamHeader(sizeof(std::int32_t), 0);
+  header.count = INT_MAX - 1;
+  const std::int32_t payload[] = { 1, 2, 3 };
+  BOOST_REQUIRE_EQUAL(::write(ends[1], &header, sizeof(header)), static_cast<ssize_t>(sizeof(header)));
+  BOOST_REQUIRE_EQUAL(::write(ends[1], payload, sizeof(payload)), static_cast<ssize_t>(sizeof(payload)));
+  ::close(ends[1]);
+  aisdi::Vector<std::int32_t> result = { 7 };
+
+  BOOST_CHECK_THROW(aisdi::deserialize(ends[0], result), std::runtime_error);
+  ::close(ends[0]);
+  BOOST_CHECK(result.isEmpty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
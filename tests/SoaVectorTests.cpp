@@ -0,0 +1,159 @@
+#include <SoaVector.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+using Records = aisdi::SoaVector<std::int32_t, double, std::string>;
+
+BOOST_AUTO_TEST_SUITE(SoaVectorTests)
+
+namespace
+{
+
+Records givenRecords(int count)
+{
+  Records records;
+  for(int i = 0; i < count; ++i)
+    records.append(i, i * 0.5, std::to_string(i));
+  return records;
+}
+
+// Assigning a negative value throws, like a copy running out of memory.
+struct Fragile
+{
+  int value = 0;
+
+  Fragile() = default;
+  explicit Fragile(int v) : value(v) {}
+  Fragile(const Fragile&) = default;
+
+  Fragile& operator=(const Fragile& other) {
+    if(other.value < 0)
+      throw std::runtime_error("copy failed");
+    value = other.value;
+    return *this;
+  }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenCreatedWithDefaultConstructor_ThenItIsEmpty)
+{
+  const Records records;
+
+  BOOST_CHECK(records.isEmpty());
+  BOOST_CHECK(records.begin() == records.end());
+  BOOST_CHECK(records.column<1>().isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenAppendingRows_ThenEachFieldLandsInItsColumn)
+{
+  Records records = givenRecords(3);
+  records.append(std::make_tuple(7, 1.5, std::string("seven")));
+
+  BOOST_CHECK_EQUAL(records.getSize(), 4);
+  BOOST_CHECK_EQUAL(records.get<0>(3), 7);
+  BOOST_CHECK_EQUAL(records.get<1>(1), 0.5);
+  BOOST_CHECK_EQUAL(records.get<2>(2), "2");
+  BOOST_CHECK_THROW(records.get<0>(4), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenScanningColumn_ThenSpanCoversAllRows)
+{
+  const Records records = givenRecords(1000);
+
+  aisdi::Span<const double> halves = records.column<1>();
+  double total = 0;
+  for(std::size_t i = 0; i < halves.getSize(); ++i)
+    total += halves[i];
+
+  BOOST_CHECK_EQUAL(halves.getSize(), 1000);
+  BOOST_CHECK_EQUAL(total, 249750.0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenErasingRow_ThenColumnsStayAligned)
+{
+  Records records = givenRecords(5);
+
+  records.erase(1);
+  records.erase(records.cbegin() + 2);
+
+  BOOST_REQUIRE_EQUAL(records.getSize(), 3);
+  for(std::size_t i = 0; i < records.getSize(); ++i) {
+    BOOST_CHECK_EQUAL(records.get<1>(i), records.get<0>(i) * 0.5);
+    BOOST_CHECK_EQUAL(records.get<2>(i), std::to_string(records.get<0>(i)));
+  }
+  BOOST_CHECK_EQUAL(records.get<0>(1), 2);
+  BOOST_CHECK_THROW(records.erase(3), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenPoppingLast_ThenWholeRowIsReturned)
+{
+  Records records = givenRecords(2);
+
+  auto row = records.popLast();
+
+  BOOST_CHECK_EQUAL(std::get<0>(row), 1);
+  BOOST_CHECK_EQUAL(std::get<2>(row), "1");
+  BOOST_CHECK_EQUAL(records.getSize(), 1);
+  records.popLast();
+  BOOST_CHECK_THROW(records.popLast(), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenIterator_WhenDereferencing_ThenRowCanBeChangedInPlace)
+{
+  Records records = givenRecords(3);
+
+  for(auto it = records.begin(); it != records.end(); ++it)
+    std::get<0>(*it) *= 10;
+  auto last = records.end() - 1;
+  std::get<2>(*last) = "last";
+
+  BOOST_CHECK_EQUAL(records.get<0>(2), 20);
+  BOOST_CHECK_EQUAL(records.get<2>(2), "last");
+  BOOST_CHECK_EQUAL(std::get<0>(*records.cbegin()), 0);
+  BOOST_CHECK_THROW(*records.end(), std::out_of_range);
+  BOOST_CHECK_THROW(records.begin()--, std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenVectorWithBoolField_WhenWritingThroughReferences_ThenFlagsAreStored)
+{
+  aisdi::SoaVector<std::int32_t, bool> flags;
+  for(int i = 0; i < 5; ++i)
+    flags.append(i, i % 2 == 0);
+
+  flags.get<1>(1) = true;
+  std::get<1>(*(flags.begin() + 2)) = false;
+  std::get<1>(flags.at(3)) = true;
+
+  const bool expected[] = { true, true, false, true, true };
+  for(int i = 0; i < 5; ++i)
+    BOOST_CHECK_EQUAL(flags.get<1>(i), expected[i]);
+  BOOST_CHECK(std::get<1>(flags.popLast()));
+  BOOST_CHECK_EQUAL(flags.column<0>().getSize(), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenColumnThatThrows_WhenAppending_ThenEarlierColumnsAreRolledBack)
+{
+  aisdi::SoaVector<std::int32_t, std::string, Fragile> rows;
+  for(int i = 0; i < 10; ++i)
+    rows.append(i, std::to_string(i), Fragile(i));
+
+  BOOST_CHECK_THROW(rows.append(10, "10", Fragile(-1)), std::runtime_error);
+
+  BOOST_CHECK_EQUAL(rows.getSize(), 10u);
+  BOOST_CHECK_EQUAL(rows.column<0>().getSize(), 10u);
+  BOOST_CHECK_EQUAL(rows.column<1>().getSize(), 10u);
+  rows.append(10, "10", Fragile(10));
+  BOOST_CHECK_EQUAL(rows.get<0>(10), 10);
+  BOOST_CHECK_EQUAL(rows.get<1>(10), "10");
+  BOOST_CHECK_EQUAL(std::get<0>(rows.popLast()), 10);
+  BOOST_CHECK_EQUAL(rows.get<2>(9).value, 9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,180 @@
+#include <TombstoneVector.h>
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedTypes = boost::mpl::list<std::int32_t, std::uint64_t, std::complex<std::int32_t>>;
+
+template <typename T>
+using TombstoneVector = aisdi::TombstoneVector<T>;
+
+namespace
+{
+
+template <typename T>
+void thenVectorContains(const TombstoneVector<T>& vector, const std::vector<int>& expected)
+{
+  BOOST_REQUIRE_EQUAL(vector.getSize(), expected.size());
+  std::size_t i = 0;
+  for(auto it = vector.begin(); it != vector.end(); ++it, ++i)
+    BOOST_REQUIRE_EQUAL(*it, T(expected[i]));
+  BOOST_REQUIRE_EQUAL(i, expected.size());
+  for(auto it = vector.end(); it != vector.begin();)
+    BOOST_REQUIRE_EQUAL(*--it, T(expected[--i]));
+}
+
+template <typename T>
+TombstoneVector<T> thenFilledVector(int count, std::size_t compactPercent)
+{
+  TombstoneVector<T> vector(compactPercent);
+  for(int i = 0; i < count; ++i)
+    vector.append(T(i));
+  return vector;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(TombstoneVectorTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyVector_ThenBeginEqualsEnd,
+                              T,
+                              TestedTypes)
+{
+  const TombstoneVector<T> vector;
+
+  BOOST_CHECK(vector.isEmpty());
+  BOOST_CHECK(vector.begin() == vector.end());
+  BOOST_CHECK_THROW(*vector.begin(), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVector_WhenErasingBelowThreshold_ThenItemsAreSkippedNotMoved,
+                              T,
+                              TestedTypes)
+{
+  TombstoneVector<T> vector = thenFilledVector<T>(10, 50);
+
+  auto next = vector.erase(vector.cbegin());
+  ++next;
+  next = vector.erase(next);
+  vector.erase(vector.cbegin(), next);
+
+  BOOST_CHECK_EQUAL(vector.getDeadCount(), 3u);
+  BOOST_CHECK_EQUAL(vector.getSlotCount(), 10u);
+  thenVectorContains(vector, { 3, 4, 5, 6, 7, 8, 9 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVector_WhenDeadFractionCrossesThreshold_ThenItIsCompacted,
+                              T,
+                              TestedTypes)
+{
+  TombstoneVector<T> vector = thenFilledVector<T>(8, 20);
+
+  auto it = vector.erase(vector.cbegin());
+  ++it;
+  it = vector.erase(it);
+
+  BOOST_CHECK_EQUAL(vector.getDeadCount(), 0u);
+  BOOST_CHECK_EQUAL(vector.getSlotCount(), 6u);
+  BOOST_CHECK_EQUAL(*it, T(3));
+  thenVectorContains(vector, { 1, 3, 4, 5, 6, 7 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVectorWithDuplicates_WhenErasingWhileIterating_ThenEachValueIsKeptOnce,
+                              T,
+                              TestedTypes)
+{
+  TombstoneVector<T> vector;
+  std::vector<int> expected;
+  for(int i = 0; i < 3000; ++i) {
+    vector.append(T(i / 3 * 3));
+    if(i % 3 == 0)
+      expected.push_back(i);
+  }
+
+  T previous = T(-1);
+  for(auto it = vector.begin(); it != vector.end();) {
+    if(*it == previous)
+      it = vector.erase(it);
+    else
+      previous = *it++;
+  }
+
+  BOOST_CHECK_LE(vector.getDeadCount() * 4, vector.getSlotCount());
+  thenVectorContains(vector, expected);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVectorWithDeadItems_WhenPoppingAndCompacting_ThenLiveItemsRemain,
+                              T,
+                              TestedTypes)
+{
+  TombstoneVector<T> vector = thenFilledVector<T>(10, 100);
+  vector.erase(--vector.cend());
+  auto last = vector.cbegin();
+  for(int i = 0; i < 8; ++i)
+    ++last;
+  vector.erase(last);
+
+  BOOST_CHECK_EQUAL(vector.popLast(), T(7));
+  BOOST_CHECK_EQUAL(vector.popFirst(), T(0));
+  BOOST_CHECK_EQUAL(vector.getDeadCount(), 1u);
+  vector.compact();
+
+  BOOST_CHECK_EQUAL(vector.getDeadCount(), 0u);
+  thenVectorContains(vector, { 1, 2, 3, 4, 5, 6 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVector_WhenRemovingIf_ThenMatchingItemsAreGoneAfterOnePass,
+                              T,
+                              TestedTypes)
+{
+  TombstoneVector<T> vector = thenFilledVector<T>(20, 100);
+
+  std::size_t removed = vector.removeIf([](const T& item) {
+    for(int i = 5; i < 18; ++i)
+      if(item == T(i))
+        return true;
+    return false;
+  });
+
+  BOOST_CHECK_EQUAL(removed, 13u);
+  BOOST_CHECK_EQUAL(vector.getSlotCount(), 7u);
+  thenVectorContains(vector, { 0, 1, 2, 3, 4, 18, 19 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyVector_WhenPoppingOrErasing_ThenExceptionIsThrown,
+                              T,
+                              TestedTypes)
+{
+  TombstoneVector<T> vector;
+
+  BOOST_CHECK_THROW(vector.popFirst(), std::logic_error);
+  BOOST_CHECK_THROW(vector.popLast(), std::logic_error);
+  BOOST_CHECK_THROW(vector.erase(vector.cend()), std::out_of_range);
+  BOOST_CHECK_THROW(--vector.cbegin(), std::out_of_range);
+  BOOST_CHECK_THROW(TombstoneVector<T>(101), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenVectorOfBools_WhenErasingAndCompacting_ThenFlagsAreKept)
+{
+  TombstoneVector<bool> vector;
+  for(int i = 0; i < 8; ++i)
+    vector.append(i % 3 == 0);
+
+  vector.erase(vector.cbegin());
+  *vector.begin() = true;
+  vector.removeIf([](bool flag) { return !flag; });
+
+  BOOST_CHECK_EQUAL(vector.getSize(), 3u);
+  for(auto it = vector.cbegin(); it != vector.cend(); ++it)
+    BOOST_CHECK(*it);
+  BOOST_CHECK(vector.popLast());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
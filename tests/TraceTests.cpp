@@ -0,0 +1,170 @@
+#include <Trace.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using RecordedTypes = boost::mpl::list<aisdi::Vector<int>, aisdi::LinkedList<int>>;
+
+using aisdi::TraceEvent;
+using aisdi::TraceOp;
+
+namespace
+{
+
+struct TemporaryFile
+{
+  std::string path;
+  int fd;
+
+  TemporaryFile() : path("/tmp/aisdi_trace_" + std::to_string(::getpid())) {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  }
+
+  ~TemporaryFile() {
+    ::close(fd);
+    std::remove(path.c_str());
+  }
+
+  std::vector<TraceEvent> readBack() {
+    ::lseek(fd, 0, SEEK_SET);
+    aisdi::TraceReader reader(fd);
+    return reader.readAll();
+  }
+};
+
+void thenEventIs(const TraceEvent& event, TraceOp op, std::uint64_t position = 0, std::uint64_t count = 0)
+{
+  BOOST_CHECK(event.op == op);
+  BOOST_CHECK_EQUAL(event.position, position);
+  BOOST_CHECK_EQUAL(event.count, count);
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(TraceTests, TemporaryFile)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenRecordingContainer_WhenModified_ThenEveryOperationIsLogged,
+                              Container,
+                              RecordedTypes)
+{
+  {
+    aisdi::TraceWriter writer(fd);
+    aisdi::Recording<Container> recording(writer);
+    recording.append(1);
+    recording.append(2);
+    recording.prepend(0);
+    recording.insert(recording.cbegin() + 2, 5);
+    recording.erase(recording.cbegin() + 1);
+    recording.erase(recording.cbegin(), recording.cbegin() + 2);
+    int total = 0;
+    recording.forEach([&total](int item) { total += item; });
+    recording.popLast();
+    BOOST_CHECK_EQUAL(total, 2);
+    BOOST_CHECK(recording.isEmpty());
+    BOOST_CHECK_EQUAL(writer.getEventCount(), 8u);
+  }
+
+  std::vector<TraceEvent> events = readBack();
+
+  BOOST_REQUIRE_EQUAL(events.size(), 8u);
+  thenEventIs(events[0], TraceOp::Append);
+  thenEventIs(events[2], TraceOp::Prepend);
+  thenEventIs(events[3], TraceOp::Insert, 2);
+  thenEventIs(events[4], TraceOp::Erase, 1, 1);
+  thenEventIs(events[5], TraceOp::Erase, 0, 2);
+  thenEventIs(events[6], TraceOp::Iterate);
+  thenEventIs(events[7], TraceOp::PopLast);
+  BOOST_CHECK_EQUAL(aisdi::validateTrace(events), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenRecordingList_WhenErasingEmptyRange_ThenNothingIsLogged)
+{
+  {
+    aisdi::TraceWriter writer(fd);
+    aisdi::Recording<aisdi::LinkedList<int>> recording(writer);
+    recording.erase(recording.cbegin(), recording.cend());
+    recording.append(1);
+    recording.erase(recording.cbegin(), recording.cbegin());
+    BOOST_CHECK_EQUAL(writer.getEventCount(), 1u);
+  }
+
+  std::vector<TraceEvent> events = readBack();
+
+  BOOST_REQUIRE_EQUAL(events.size(), 1u);
+  thenEventIs(events[0], TraceOp::Append);
+}
+
+BOOST_AUTO_TEST_CASE(GivenLargePositions_WhenWrittenAndRead_ThenVarintsRoundTrip)
+{
+  {
+    aisdi::TraceWriter writer(fd);
+    writer.record(TraceOp::Insert, 127);
+    writer.record(TraceOp::Erase, 128, 300);
+    writer.record(TraceOp::Erase, UINT64_MAX, 1);
+    writer.record(TraceOp::PopFirst);
+  }
+
+  std::vector<TraceEvent> events = readBack();
+
+  BOOST_REQUIRE_EQUAL(events.size(), 4u);
+  thenEventIs(events[0], TraceOp::Insert, 127);
+  thenEventIs(events[1], TraceOp::Erase, 128, 300);
+  thenEventIs(events[2], TraceOp::Erase, UINT64_MAX, 1);
+  thenEventIs(events[3], TraceOp::PopFirst);
+  BOOST_CHECK_EQUAL(::lseek(fd, 0, SEEK_END), off_t(sizeof(aisdi::detail::TraceHeader) + 2 + 5 + 12 + 1));
+}
+
+BOOST_AUTO_TEST_CASE(GivenManyEvents_WhenWritten_ThenTheyAreFlushedInChunks)
+{
+  {
+    aisdi::TraceWriter writer(fd);
+    for(int i = 0; i < 100000; ++i)
+      writer.record(TraceOp::Insert, i);
+  }
+
+  std::vector<TraceEvent> events = readBack();
+
+  BOOST_REQUIRE_EQUAL(events.size(), 100000u);
+  thenEventIs(events[99999], TraceOp::Insert, 99999);
+}
+
+BOOST_AUTO_TEST_CASE(GivenImpossibleTrace_WhenValidated_ThenExceptionIsThrown)
+{
+  std::vector<TraceEvent> popEmpty = { { TraceOp::PopFirst, 0, 0 } };
+  std::vector<TraceEvent> insertPastEnd = { { TraceOp::Append, 0, 0 }, { TraceOp::Insert, 2, 0 } };
+  std::vector<TraceEvent> eraseTooMany = { { TraceOp::Append, 0, 0 }, { TraceOp::Erase, 0, 2 } };
+
+  BOOST_CHECK_THROW(aisdi::validateTrace(popEmpty), std::runtime_error);
+  BOOST_CHECK_THROW(aisdi::validateTrace(insertPastEnd), std::runtime_error);
+  BOOST_CHECK_THROW(aisdi::validateTrace(eraseTooMany), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenStreamWithoutTraceHeader_WhenRead_ThenExceptionIsThrown)
+{
+  BOOST_REQUIRE_EQUAL(::write(fd, "NOPE1234", 8), 8);
+
+  BOOST_CHECK_THROW(readBack(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenTraceCutInsideRecord_WhenRead_ThenExceptionIsThrown)
+{
+  {
+    aisdi::TraceWriter writer(fd);
+    writer.record(TraceOp::Erase, 1000, 1);
+  }
+  BOOST_REQUIRE_EQUAL(::ftruncate(fd, sizeof(aisdi::detail::TraceHeader) + 2), 0);
+
+  BOOST_CHECK_THROW(readBack(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,164 @@
+#include <Vector.h>
+
+#include <initializer_list>
+#include <cstddef>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+using BitVector = aisdi::Vector<bool>;
+
+using std::begin;
+using std::end;
+
+BOOST_AUTO_TEST_SUITE(VectorBoolTests)
+
+namespace
+{
+
+void thenVectorContainsValues(const BitVector& vector, std::initializer_list<bool> expected)
+{
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(vector), end(vector), begin(expected), end(expected));
+}
+
+// Every third flag set, enough flags to span several words.
+BitVector givenPattern(std::size_t size)
+{
+  BitVector vector;
+  for(std::size_t i = 0; i < size; ++i)
+    vector.append(i % 3 == 0);
+  return vector;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenCreatedWithDefaultConstructor_ThenItIsEmpty)
+{
+  const BitVector vector;
+
+  BOOST_CHECK(vector.isEmpty());
+  BOOST_CHECK(vector.begin() == vector.end());
+  BOOST_CHECK_EQUAL(vector.findFirst(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenAppendingManyFlags_ThenTheyArePacked)
+{
+  const BitVector vector = givenPattern(1000);
+
+  BOOST_CHECK_EQUAL(vector.getSize(), 1000u);
+  BOOST_CHECK_EQUAL(vector.wordCount(), 16u);
+  BOOST_CHECK(*(vector.begin() + 999));
+  BOOST_CHECK(!*(vector.begin() + 998));
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenCounting_ThenSetAndClearFlagsAreCounted)
+{
+  const BitVector vector = givenPattern(1000);
+
+  BOOST_CHECK_EQUAL(vector.count(), 334u);
+  BOOST_CHECK_EQUAL(vector.count(false), 666u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenScanningSetFlags_ThenEachIsVisitedOnce)
+{
+  BitVector vector = givenPattern(200);
+  std::size_t visited = 0;
+
+  for(std::size_t i = vector.findFirst(); i != vector.getSize(); i = vector.findNext(i)) {
+    BOOST_REQUIRE_EQUAL(i % 3, 0u);
+    ++visited;
+  }
+
+  BOOST_CHECK_EQUAL(visited, 67u);
+  BOOST_CHECK_EQUAL(vector.findNext(198), 200u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenWritingThroughIterator_ThenFlagChanges)
+{
+  BitVector vector = { false, false, true };
+
+  *vector.begin() = true;
+  (*(vector.begin() + 2)).flip();
+  *(vector.begin() + 1) = *vector.begin();
+
+  thenVectorContainsValues(vector, { true, true, false });
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenInsertingAndErasingAcrossWords_ThenFlagsShift)
+{
+  BitVector vector = givenPattern(130);
+  BitVector expected;
+  expected.append(true);
+  for(std::size_t i = 0; i < 130; ++i)
+    expected.append(i % 3 == 0);
+
+  vector.prepend(true);
+  BOOST_CHECK_EQUAL_COLLECTIONS(vector.begin(), vector.end(), expected.begin(), expected.end());
+
+  vector.erase(vector.begin() + 63);
+  vector.insert(vector.begin() + 63, *(expected.begin() + 63));
+  BOOST_CHECK_EQUAL_COLLECTIONS(vector.begin(), vector.end(), expected.begin(), expected.end());
+
+  BOOST_CHECK(vector.popFirst());
+  BOOST_CHECK_EQUAL(vector.count(), 44u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenErasingRange_ThenRemainingFlagsAreKept)
+{
+  BitVector vector = { true, false, false, true, true };
+
+  vector.erase(vector.begin() + 1, vector.begin() + 3);
+
+  thenVectorContainsValues(vector, { true, true, true });
+  BOOST_CHECK_EQUAL(vector.count(), 3u);
+  BOOST_CHECK(vector.popLast());
+  BOOST_CHECK_EQUAL(vector.count(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenTwoVectors_WhenCombiningBitwise_ThenWordsAreCombined)
+{
+  BitVector a = givenPattern(100);
+  BitVector b;
+  for(std::size_t i = 0; i < 100; ++i)
+    b.append(i % 2 == 0);
+
+  BitVector both = a;
+  both &= b;
+  BitVector either = a;
+  either |= b;
+  BitVector one = a;
+  one ^= b;
+
+  BOOST_CHECK_EQUAL(both.count(), 17u);
+  BOOST_CHECK_EQUAL(either.count(), 67u);
+  BOOST_CHECK_EQUAL(one.count(), 50u);
+  BOOST_CHECK_THROW(a &= BitVector(), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenFindingValue_ThenFirstMatchIsReturned)
+{
+  const BitVector vector = { true, true, false, true };
+
+  BOOST_CHECK(vector.find(false) == vector.begin() + 2);
+  BOOST_CHECK(vector.find(true) == vector.begin());
+  BOOST_CHECK(!BitVector{ true }.contains(false));
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenErasingIf_ThenKeptFlagsArePackedInOrder)
+{
+  BitVector vector = givenPattern(200);
+  std::size_t visited = 0;
+
+  BOOST_CHECK_EQUAL(aisdi::eraseIf(vector, [&visited](bool) { return visited++ % 2 == 0; }), 100u);
+
+  BOOST_REQUIRE_EQUAL(vector.getSize(), 100u);
+  for(std::size_t i = 0; i < 100; ++i)
+    BOOST_CHECK_EQUAL(*(vector.cbegin() + i), (2 * i + 1) % 3 == 0);
+  BOOST_CHECK_EQUAL(aisdi::eraseIf(vector, [](bool flag) { return flag; }), 33u);
+  BOOST_CHECK_EQUAL(vector.count(), 0u);
+  vector.append(false);
+  BOOST_CHECK_EQUAL(vector.count(), 0u);
+  BOOST_CHECK_EQUAL(vector.getSize(), 68u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,8 +1,13 @@
 #include <Vector.h>
 
 #include <initializer_list>
+#include <climits>
 #include <complex>
 #include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/test_tools.hpp>
@@ -10,6 +15,7 @@
 #include <boost/mpl/list.hpp>
 
 using TestedTypes = boost::mpl::list<std::int32_t, std::uint64_t, std::complex<std::int32_t>>;
+using ArithmeticTypes = boost::mpl::list<std::int32_t, std::uint64_t, float, double>;
 
 template <typename T>
 using LinearCollection = aisdi::Vector<T>;
@@ -716,6 +722,369 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingRange_ThenSizeI
   BOOST_CHECK_EQUAL(collection.getSize(), 2);
 }
 
+template <typename T>
+LinearCollection<T> givenCollectionOfSize(int size)
+{
+  LinearCollection<T> collection;
+  for(int i = 0; i < size; ++i)
+    collection.append(T(i % 50 + 1));
+  return collection;
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenFinding_ThenEndIsReturned,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection;
+
+  BOOST_CHECK(collection.find(T(1)) == collection.cend());
+  BOOST_CHECK(!collection.contains(T(1)));
+  BOOST_CHECK_EQUAL(collection.indexOf(T(1)), -1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenFinding_ThenFirstMatchIsReturned,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = givenCollectionOfSize<T>(203);
+  collection.append(T(777));
+
+  BOOST_CHECK(collection.find(T(7)) == collection.cbegin() + 6);
+  BOOST_CHECK(collection.find(T(777)) == collection.cend() - 1);
+  BOOST_CHECK_EQUAL(collection.indexOf(T(50)), 49);
+  BOOST_CHECK(collection.contains(T(777)));
+  BOOST_CHECK(!collection.contains(T(778)));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIteratorFromFind_WhenDereferencing_ThenItemCanBeChanged,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 4, 8, 15 };
+
+  *collection.find(T(8)) = T(16);
+
+  thenCollectionContainsValues(collection, { 4, 16, 15 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenCounting_ThenAllMatchesAreCounted,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection = givenCollectionOfSize<T>(1037);
+
+  BOOST_CHECK_EQUAL(collection.count(T(3)), 21);
+  BOOST_CHECK_EQUAL(collection.count(T(50)), 20);
+  BOOST_CHECK_EQUAL(collection.count(T(51)), 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenGettingMinOrMax_ThenOperationThrows,
+                              T,
+                              ArithmeticTypes)
+{
+  const LinearCollection<T> collection;
+
+  BOOST_CHECK_THROW(collection.min(), std::logic_error);
+  BOOST_CHECK_THROW(collection.max(), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenGettingMinAndMax_ThenExtremesAreReturned,
+                              T,
+                              ArithmeticTypes)
+{
+  for(int size : { 1, 3, 17, 64, 333 }) {
+    LinearCollection<T> collection = givenCollectionOfSize<T>(size);
+    collection.insert(collection.cbegin() + size / 2, T(100));
+    collection.insert(collection.cbegin() + size / 3, T(0));
+
+    BOOST_CHECK_EQUAL(collection.min(), T(0));
+    BOOST_CHECK_EQUAL(collection.max(), T(100));
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenSumming_ThenTotalIsReturned,
+                              T,
+                              TestedTypes)
+{
+  BOOST_CHECK_EQUAL(LinearCollection<T>().sum(), T());
+  BOOST_CHECK_EQUAL(givenCollectionOfSize<T>(7).sum(), T(28));
+  BOOST_CHECK_EQUAL(givenCollectionOfSize<T>(1000).sum(), T(25500));
+}
+
+namespace
+{
+
+template <typename Pointer>
+std::uintptr_t misalignment(Pointer pointer, std::size_t alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(pointer) % alignment;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenGrowingCollection_WhenReallocating_ThenBufferStaysAligned,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+  aisdi::Vector<T, 256> wide;
+
+  for(int i = 0; i < 1000; ++i) {
+    collection.append(T(i));
+    wide.prepend(T(i));
+    BOOST_REQUIRE_EQUAL(misalignment(collection.data(), 64), 0);
+    BOOST_REQUIRE_EQUAL(misalignment(wide.data(), 256), 0);
+  }
+  BOOST_CHECK(collection.alignedData() == collection.data());
+  BOOST_CHECK_EQUAL(std::size_t(LinearCollection<T>::ALIGNMENT), 64);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenHugePagesEnabled_WhenGrowingPastThreshold_ThenItemsArePreserved,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { T(0), T(1), T(2) };
+  collection.setHugePages(true);
+  const int size = static_cast<int>(aisdi::detail::HUGE_PAGE_SIZE / sizeof(T)) + 1000;
+
+  for(int i = 3; i < size; ++i)
+    collection.append(T(i));
+  LinearCollection<T> moved = std::move(collection);
+  moved.setHugePages(false);
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(!moved.usesHugePages());
+  BOOST_REQUIRE_EQUAL(moved.getSize(), static_cast<std::size_t>(size));
+  BOOST_CHECK_EQUAL(misalignment(moved.alignedData(), 64), 0);
+  for(int i = 0; i < size; i += 4099)
+    BOOST_REQUIRE_EQUAL(*(moved.cbegin() + i), T(i));
+}
+
+namespace
+{
+
+int adoptedFrees = 0;
+
+// Buffers as the I/O layer hands them out: raw aligned memory with elements
+// constructed in place.
+template <typename T>
+T* makeForeignBuffer(std::size_t capacity)
+{
+  void* raw = nullptr;
+  if(posix_memalign(&raw, 64, capacity * sizeof(T)))
+    throw std::bad_alloc();
+  T* data = static_cast<T*>(raw);
+  for(std::size_t i = 0; i < capacity; ++i)
+    new (data + i) T(static_cast<std::int32_t>(i));
+  return data;
+}
+
+template <typename T>
+void freeForeignBuffer(T* data, std::size_t capacity)
+{
+  for(std::size_t i = 0; i < capacity; ++i)
+    data[i].~T();
+  std::free(data);
+  ++adoptedFrees;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenForeignBuffer_WhenAdoptedAndOutgrown_ThenItemsAreKeptAndBufferIsFreedOnce,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { T(7) };
+  T* data = makeForeignBuffer<T>(16);
+  adoptedFrees = 0;
+
+  collection.adopt(data, 12, 16, &freeForeignBuffer<T>);
+
+  BOOST_CHECK(collection.data() == data);
+  BOOST_CHECK(!collection.ownsBuffer());
+  BOOST_CHECK_EQUAL(collection.getSize(), 12u);
+  for(int i = 12; i < 40; ++i)
+    collection.append(T(i));
+  BOOST_CHECK(collection.ownsBuffer());
+  BOOST_CHECK_EQUAL(adoptedFrees, 1);
+  for(int i = 0; i < 40; ++i)
+    BOOST_REQUIRE_EQUAL(*(collection.cbegin() + i), T(i));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenReleasedAndAdoptedElsewhere_ThenBufferIsNotCopied,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+  for(int i = 0; i < 100; ++i)
+    collection.append(T(i));
+  const T* data = collection.data();
+
+  auto buffer = collection.release();
+  LinearCollection<T> other;
+  other.adopt(buffer.data, buffer.size, buffer.capacity, buffer.deleter);
+  other.popFirst();
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(other.data() == data);
+  BOOST_REQUIRE_EQUAL(other.getSize(), 99u);
+  BOOST_CHECK_EQUAL(*other.cbegin(), T(1));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenWritingThroughSubspan_ThenItemsAreChanged,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { T(0), T(1), T(2), T(3), T(4) };
+
+  aisdi::Span<T> middle = collection.subspan(1, 3);
+  for(T& item : middle)
+    item = T(-1);
+  const LinearCollection<T>& view = collection;
+
+  BOOST_CHECK(view.span().data() == view.data());
+  BOOST_CHECK_EQUAL(view.span().getSize(), 5u);
+  BOOST_CHECK_EQUAL(*view.cbegin(), T(0));
+  BOOST_CHECK_EQUAL(*(view.cbegin() + 3), T(-1));
+  BOOST_CHECK_EQUAL(*(view.cbegin() + 4), T(4));
+  BOOST_CHECK_THROW(collection.subspan(3, 3), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenInvalidBuffer_WhenAdopting_ThenExceptionIsThrownAndItemsAreKept,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { T(1), T(2) };
+  T* data = makeForeignBuffer<T>(8);
+
+  BOOST_CHECK_THROW(collection.adopt(data, 9, 8, &freeForeignBuffer<T>), std::out_of_range);
+  BOOST_CHECK_THROW(collection.adopt(data, 2, 8, nullptr), std::invalid_argument);
+  BOOST_CHECK_THROW(collection.adopt(data + 1, 2, 7, &freeForeignBuffer<T>), std::invalid_argument);
+
+  BOOST_CHECK(collection.ownsBuffer());
+  BOOST_CHECK_EQUAL(collection.getSize(), 2u);
+  freeForeignBuffer(data, 8);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenReservingMoreThanIntRange_ThenExceptionIsThrownAndItemsAreKept,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { T(1), T(2) };
+
+  BOOST_CHECK_THROW(collection.reserve(std::size_t(1) << 32), std::out_of_range);
+  BOOST_CHECK_THROW(collection.reserve(static_cast<std::size_t>(INT_MAX)), std::out_of_range);
+
+  collection.append(T(3));
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoCollections_WhenSwapping_ThenBuffersAreExchanged,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> first = { T(1), T(2), T(3) };
+  LinearCollection<T> second = { T(4) };
+  const T* firstData = first.data();
+
+  first.swap(second);
+
+  BOOST_CHECK(second.data() == firstData);
+  BOOST_CHECK_EQUAL(first.getSize(), 1u);
+  BOOST_CHECK_EQUAL(second.getSize(), 3u);
+  BOOST_CHECK_EQUAL(*first.cbegin(), T(4));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenRemovingIf_ThenOnlyNonMatchingItemsRemainInOrder,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 4, 5, 6, 7 };
+
+  auto removed = collection.removeIf([](const T& item) { return item == T(2) || item == T(3) || item == T(6); });
+  auto none = aisdi::eraseIf(collection, [](const T& item) { return item == T(100); });
+
+  BOOST_CHECK_EQUAL(removed, 3u);
+  BOOST_CHECK_EQUAL(none, 0u);
+  BOOST_REQUIRE_EQUAL(collection.getSize(), 4u);
+  BOOST_CHECK_EQUAL(*collection.cbegin(), T(1));
+  BOOST_CHECK_EQUAL(*(collection.cbegin() + 1), T(4));
+  BOOST_CHECK_EQUAL(*(collection.cbegin() + 2), T(5));
+  BOOST_CHECK_EQUAL(*(collection.cbegin() + 3), T(7));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenApplyingMixedEdits_ThenItemsAreMergedInOrder,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 0, 1, 2, 3, 4, 5 };
+  using Edit = aisdi::Edit<T>;
+  std::vector<Edit> edits = { Edit::insert(0, T(-1)), Edit::erase(1), Edit::erase(2), Edit::insert(4, T(40)),
+                              Edit::insert(4, T(41)), Edit::replace(4, T(44)), Edit::insert(6, T(60)) };
+
+  collection.applyEdits(edits);
+
+  thenCollectionContainsValues(collection, { -1, 0, 3, 40, 41, 44, 5, 60 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenApplyingRandomEditBatches_ThenResultMatchesReference,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+  std::vector<int> reference;
+  std::mt19937 random(47);
+
+  for(int round = 0; round < 200; ++round) {
+    std::vector<aisdi::Edit<T>> edits;
+    std::vector<int> expected;
+    std::size_t from = 0;
+    for(std::size_t position = 0; position <= reference.size(); ++position) {
+      for(; from < position; ++from)
+        expected.push_back(reference[from]);
+      while(random() % 4 == 0) {
+        int value = round * 1000 + static_cast<int>(expected.size());
+        edits.push_back(aisdi::Edit<T>::insert(position, T(value)));
+        expected.push_back(value);
+      }
+      if(position == reference.size())
+        break;
+      unsigned choice = random() % 6;
+      if(choice == 0 || (choice < 3 && reference.size() > 500)) {
+        edits.push_back(aisdi::Edit<T>::erase(position));
+        ++from;
+      }
+      else if(choice == 1) {
+        edits.push_back(aisdi::Edit<T>::replace(position, T(-round)));
+        expected.push_back(-round);
+        ++from;
+      }
+    }
+
+    collection.applyEdits(edits);
+    reference = expected;
+
+    BOOST_REQUIRE_EQUAL(collection.getSize(), reference.size());
+    for(std::size_t i = 0; i < reference.size(); ++i)
+      BOOST_REQUIRE_EQUAL(*(collection.cbegin() + i), T(reference[i]));
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenApplyingUnsortedEdits_ThenExceptionIsThrownAndItemsAreKept,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+  using Edit = aisdi::Edit<T>;
+
+  BOOST_CHECK_THROW(collection.applyEdits(std::vector<Edit>{ Edit::erase(2), Edit::erase(1) }), std::invalid_argument);
+  BOOST_CHECK_THROW(collection.applyEdits(std::vector<Edit>{ Edit::erase(1), Edit::insert(1, T(0)) }),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(collection.applyEdits(std::vector<Edit>{ Edit::erase(3) }), std::out_of_range);
+
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+}
+
 // ConstIterator is tested via Iterator methods.
 // If Iterator methods are to be changed, then new ConstIterator tests are required.
 